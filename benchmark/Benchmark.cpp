@@ -0,0 +1,143 @@
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include "Data.h"
+#include "NetworkGenerator.h"
+
+/**
+ * @details Runs a function and measures how long it took
+ * @param function The function
+ * @return The time in milliseconds
+ */
+static double timeMs(const function<void()> &function) {
+    auto start = chrono::steady_clock::now();
+    function();
+    return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+/**
+ * @details Prints a cell of the scaling table
+ * @param value The value, negative when it wasn't measured
+ * @param width Width of the cell
+ */
+static void printCell(double value, int width) {
+    if (value < 0) {
+        cout << setw(width) << "-" << " |";
+    } else {
+        cout << setw(width) << fixed << setprecision(2) << value << " |";
+    }
+}
+
+/**
+ * @details Generates synthetic networks of increasing sizes and prints how long the main operations take on each one
+ * @details Usage: DA2324_Proj1_Benchmark [--keep] [--ek-limit N] [--pipeline-limit N] [--seed S] [sizes...]
+ * @details The networks are written to the current directory as *_Synthetic<size>.csv, and removed unless --keep is given.
+ * Edmonds-Karp is only measured on networks with at most --ek-limit nodes, 20000 by default, and evaluatePipelineImpact
+ * on networks with at most --pipeline-limit nodes, 10000 by default, as their time grows quadratically or worse.
+ */
+int main(int argc, char* argv[]) {
+    vector<int> sizes;
+    bool keep = false;
+    int edmondsKarpLimit = 20000;
+    int pipelineLimit = 10000;
+    unsigned seed = 2324;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--keep") {
+            keep = true;
+        } else if (arg == "--ek-limit" && i + 1 < argc) {
+            edmondsKarpLimit = stoi(argv[++i]);
+        } else if (arg == "--pipeline-limit" && i + 1 < argc) {
+            pipelineLimit = stoi(argv[++i]);
+        } else if (arg == "--seed" && i + 1 < argc) {
+            seed = (unsigned) stoul(argv[++i]);
+        } else {
+            sizes.push_back(stoi(arg));
+        }
+    }
+    if (sizes.empty()) {
+        sizes = {1000, 10000, 100000, 1000000};
+    }
+
+    const vector<pair<string, int>> columns = {
+            {"Nodes", 9}, {"Pipes", 9}, {"readData", 10}, {"compile", 9}, {"EdmondsKarp", 11}, {"Dinic", 9},
+            {"PushRelabel", 11}, {"WaterDeficit", 12}, {"ComputeMetrics", 14}, {"PipelineImpact", 14}};
+    int tableWidth = 1;
+    for (const auto& column : columns) tableWidth += column.second + 2;
+    cout << "Times in milliseconds, seed " << seed << "\n";
+    for (int i = 0; i < tableWidth; i++) cout << "-";
+    cout << "\n|";
+    for (const auto& column : columns) cout << setw(column.second) << column.first << " |";
+    cout << "\n";
+    for (int i = 0; i < tableWidth; i++) cout << "-";
+    cout << "\n";
+
+    for (int size : sizes) {
+        string extension = "_Synthetic" + to_string(size);
+        long long pipes = NetworkGenerator::generate("", extension, size, seed);
+        if (pipes < 0) {
+            cerr << "Couldn't write the files of the network with " << size << " nodes\n";
+            continue;
+        }
+        DatasetFiles files = DatasetFiles::fromExtension(extension);
+        files.reservoirs = "Reservoirs" + extension + ".csv";
+        files.stations = "Stations" + extension + ".csv";
+        files.cities = "Cities" + extension + ".csv";
+        files.pipes = "Pipes" + extension + ".csv";
+        files.snapshot.clear();
+
+        Data data;
+        Graph& graph = data.getWaterNetwork();
+        double read = timeMs([&] { data.readData(files); });
+        double compile = timeMs([&] { graph.getFlowNetwork(); });
+        vector<double> engines;
+        long long flow = -1;
+        for (FlowAlgorithm algorithm : {FlowAlgorithm::EdmondsKarp, FlowAlgorithm::Dinic, FlowAlgorithm::PushRelabel}) {
+            if (algorithm == FlowAlgorithm::EdmondsKarp && size > edmondsKarpLimit) {
+                engines.push_back(-1);
+                continue;
+            }
+            graph.setFlowAlgorithm(algorithm);
+            engines.push_back(timeMs([&] { graph.maxFlow(); }));
+            long long total = graph.getFlowNetwork().getTotalFlow();
+            if (flow >= 0 && total != flow) {
+                cerr << "The engines disagree on the network with " << size << " nodes: " << flow << " and " << total << "\n";
+            }
+            flow = total;
+        }
+        double deficit = timeMs([&] {
+            int totalSupply = 0;
+            float totalDemand = 0;
+            graph.WaterDeficit(totalSupply, totalDemand);
+        });
+        double metrics = timeMs([&] {
+            double maxDifference = 0, averageDifference = 0, variance = 0;
+            graph.ComputeMetrics(maxDifference, averageDifference, variance);
+        });
+        double pipeline = -1;
+        if (size <= pipelineLimit) {
+            graph.setFlowAlgorithm(FlowAlgorithm::Dinic);
+            pipeline = timeMs([&] { graph.evaluatePipelineImpact(); });
+        }
+
+        cout << "|" << setw(columns[0].second) << size << " |" << setw(columns[1].second) << pipes << " |";
+        printCell(read, columns[2].second);
+        printCell(compile, columns[3].second);
+        for (size_t i = 0; i < engines.size(); i++) printCell(engines[i], columns[4 + i].second);
+        printCell(deficit, columns[7].second);
+        printCell(metrics, columns[8].second);
+        printCell(pipeline, columns[9].second);
+        cout << endl;
+
+        if (!keep) {
+            for (const string& file : {files.reservoirs, files.stations, files.cities, files.pipes}) {
+                remove(file.c_str());
+            }
+        }
+    }
+    for (int i = 0; i < tableWidth; i++) cout << "-";
+    cout << "\n";
+    return 0;
+}
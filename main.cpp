@@ -1,6 +1,11 @@
+#include <string>
 #include "src/Menu.h"
+#include "src/BatchQuery.h"
 
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1 && string(argv[1]) == "--batch") {
+        return BatchQuery::run(argc, argv);
+    }
     Menu menu = Menu();
     return 0;
 }
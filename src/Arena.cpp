@@ -0,0 +1,66 @@
+#include "Arena.h"
+
+#include <algorithm>
+
+Arena::Arena(size_t blockSize) : blockSize(blockSize) {}
+
+Arena::~Arena() {
+    clear();
+}
+
+Arena::Arena(Arena&& other) noexcept : blockSize(other.blockSize) {
+    *this = std::move(other);
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+    if (this != &other) {
+        clear();
+        blockSize = other.blockSize;
+        blocks = std::move(other.blocks);
+        destructors = std::move(other.destructors);
+        offset = other.offset;
+        capacity = other.capacity;
+        reservedBytes = other.reservedBytes;
+        usedBytes = other.usedBytes;
+        objects = other.objects;
+        other.blocks.clear();
+        other.destructors.clear();
+        other.offset = other.capacity = other.reservedBytes = other.usedBytes = other.objects = 0;
+    }
+    return *this;
+}
+
+void* Arena::allocate(size_t size, size_t alignment) {
+    size_t start = (offset + alignment - 1) / alignment * alignment;
+    if (blocks.empty() || start + size > capacity) {
+        // Blocks come from new[], which aligns them for any fundamental type
+        capacity = max(blockSize, size);
+        blocks.emplace_back(new char[capacity]);
+        reservedBytes += capacity;
+        start = 0;
+    }
+    offset = start + size;
+    usedBytes += size;
+    return blocks.back().get() + start;
+}
+
+void Arena::clear() {
+    for (auto it = destructors.rbegin(); it != destructors.rend(); it++) {
+        it->second(it->first);
+    }
+    destructors.clear();
+    blocks.clear();
+    offset = capacity = reservedBytes = usedBytes = objects = 0;
+}
+
+size_t Arena::getNumObjects() const {
+    return objects;
+}
+
+size_t Arena::getReservedBytes() const {
+    return reservedBytes;
+}
+
+size_t Arena::getUsedBytes() const {
+    return usedBytes;
+}
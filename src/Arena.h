@@ -0,0 +1,126 @@
+#ifndef DA2324_PROJ1_ARENA_H
+#define DA2324_PROJ1_ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class Arena
+ * @details Owns objects of any type, constructed one after the other in large blocks of memory.
+ * @details Objects are never freed one at a time: all of them are destroyed, in reverse order of creation, and their
+ * blocks freed together when the Arena is cleared, destroyed or assigned. Only the objects with a destructor that
+ * does something are remembered for that.
+ */
+class Arena {
+private:
+    /**
+     * @details Size of the blocks, objects larger than this get a block of their own
+     */
+    size_t blockSize;
+    /**
+     * @details Blocks of memory, the last one is where the next objects are constructed
+     */
+    vector<unique_ptr<char[]>> blocks;
+    /**
+     * @details Position of the first free byte of the last block
+     */
+    size_t offset = 0;
+    /**
+     * @details Size of the last block
+     */
+    size_t capacity = 0;
+    /**
+     * @details Objects that have to be destroyed, with the function that destroys them
+     */
+    vector<pair<void*, void (*)(void*)>> destructors;
+    /**
+     * @details Number of bytes of all the blocks
+     */
+    size_t reservedBytes = 0;
+    /**
+     * @details Number of bytes taken by the objects
+     */
+    size_t usedBytes = 0;
+    /**
+     * @details Number of objects constructed since the Arena was last cleared
+     */
+    size_t objects = 0;
+    /**
+     * @details Finds room for an object, starting a new block if the last one is full
+     * @details Time Complexity: O(1)
+     * @param size Size of the object
+     * @param alignment Alignment of the object
+     * @return Memory for the object
+     */
+    void* allocate(size_t size, size_t alignment);
+public:
+    /**
+     * @details Constructor of the Arena class, no memory is allocated until the first object is created
+     * @param blockSize Size of the blocks of memory
+     */
+    explicit Arena(size_t blockSize = 64 * 1024);
+    /**
+     * @details Destroys all the objects and frees the blocks
+     */
+    ~Arena();
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    /**
+     * @details Takes the objects of another Arena, which is left empty. The objects don't move.
+     * @param other The other Arena
+     */
+    Arena(Arena&& other) noexcept;
+    /**
+     * @details Destroys all the objects and takes the ones of another Arena, which is left empty. The objects don't move.
+     * @param other The other Arena
+     * @return This Arena
+     */
+    Arena& operator=(Arena&& other) noexcept;
+    /**
+     * @details Constructs an object in the Arena, which owns it until it is cleared
+     * @details Time Complexity: O(1) amortized, plus the constructor of the object
+     * @param args Arguments of the constructor
+     * @return The object
+     */
+    template<typename T, typename... Args>
+    T* create(Args&&... args) {
+        T* object = new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        if (!is_trivially_destructible<T>::value) {
+            destructors.emplace_back(object, [](void* p) { static_cast<T*>(p)->~T(); });
+        }
+        objects++;
+        return object;
+    }
+    /**
+     * @details Destroys all the objects and frees the blocks
+     * @details Time Complexity: O(N + B)
+     * @details N is the number of objects with a destructor and B the number of blocks.
+     */
+    void clear();
+    /**
+     * @details Normal method that returns the number of objects in the Arena
+     * @details Time Complexity: O(1)
+     * @return The number of objects
+     */
+    size_t getNumObjects() const;
+    /**
+     * @details Normal method that returns the memory taken by the blocks
+     * @details Time Complexity: O(1)
+     * @return The number of bytes of all the blocks
+     */
+    size_t getReservedBytes() const;
+    /**
+     * @details Normal method that returns the memory taken by the objects, without the padding and the unused end of the blocks
+     * @details Time Complexity: O(1)
+     * @return The number of bytes of all the objects
+     */
+    size_t getUsedBytes() const;
+};
+
+#endif //DA2324_PROJ1_ARENA_H
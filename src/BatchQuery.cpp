@@ -0,0 +1,279 @@
+#include "BatchQuery.h"
+
+BatchQuery::BatchQuery(Data &data) : data(data) {
+    data.getWaterNetwork().maxFlow();
+}
+
+string BatchQuery::format(double value) {
+    stringstream x;
+    x << fixed << setprecision(2) << value;
+    return x.str();
+}
+
+BatchQuery::Query BatchQuery::parse(const string &line, vector<Scenario> &scenarios) {
+    Query query;
+    stringstream words(line);
+    string word;
+    while (words >> word) {
+        query.words.push_back(word);
+    }
+    Graph& graph = data.getWaterNetwork();
+    const string& command = query.words.front();
+    size_t arguments = query.words.size() - 1;
+    if (command == "flow") {
+        if (arguments > 1) {
+            query.error = "usage: flow [city]";
+        } else if (arguments == 1 && !dynamic_cast<City*>(graph.getNode(query.words[1]))) {
+            query.error = "not a city: " + query.words[1];
+        }
+    } else if (command == "reach") {
+        if (arguments != 1) {
+            query.error = "usage: reach <city>";
+        } else if (!dynamic_cast<City*>(graph.getNode(query.words[1]))) {
+            query.error = "not a city: " + query.words[1];
+        }
+    } else if (command == "deficit" || command == "totals" || command == "mincut") {
+        if (arguments != 0) {
+            query.error = "usage: " + command;
+        }
+    } else if (command == "reservoir" || command == "station") {
+        if (arguments != 1) {
+            query.error = "usage: " + command + " <code>";
+        } else {
+            query.scenario = (int) scenarios.size();
+            scenarios.push_back(command == "reservoir" ? Scenario::removeReservoir(query.words[1]) : Scenario::removePumpingStation(query.words[1]));
+        }
+    } else if (command == "pipe") {
+        if (arguments != 2) {
+            query.error = "usage: pipe <origin> <destination>";
+        } else {
+            query.scenario = (int) scenarios.size();
+            scenarios.push_back(Scenario::removePipe(query.words[1], query.words[2]));
+        }
+    } else if (command == "demand") {
+        char* end = nullptr;
+        double factor = arguments == 2 ? strtod(query.words[2].c_str(), &end) : 0;
+        if (arguments != 2) {
+            query.error = "usage: demand <city> <factor>";
+        } else if (end == query.words[2].c_str() || *end != '\0') {
+            query.error = "not a number: " + query.words[2];
+        } else {
+            query.scenario = (int) scenarios.size();
+            scenarios.push_back(Scenario::scaleDemand(query.words[1], factor));
+        }
+    } else if (command == "simulate") {
+        if (arguments != 1) {
+            query.error = "usage: simulate <profiles>";
+        }
+    } else if (command == "cutoff") {
+        if (arguments != 1 && arguments != 2) {
+            query.error = "usage: cutoff <code> | cutoff <origin> <destination>";
+        } else {
+            for (size_t i = 1; i <= arguments; i++) {
+                if (graph.getNode(query.words[i]) == nullptr) {
+                    query.error = "no node with the code " + query.words[i];
+                    break;
+                }
+            }
+        }
+    } else {
+        query.error = "unknown query: " + command;
+    }
+    return query;
+}
+
+int BatchQuery::writeDeficits(const string &prefix, const list<pair<City*, double>> &deficits, ostream &out) {
+    for (const auto& pair : deficits) {
+        out << prefix << '\t' << pair.first->getCode() << '\t' << format(pair.second) << '\n';
+    }
+    return (int) deficits.size();
+}
+
+int BatchQuery::execute(istream &in, ostream &out, bool table) {
+    Graph& graph = data.getWaterNetwork();
+    vector<Query> queries;
+    vector<Scenario> scenarios;
+    string line;
+    while (getline(in, line)) {
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == string::npos || line[start] == '#') {
+            continue;
+        }
+        queries.push_back(parse(line, scenarios));
+    }
+
+    ScenarioTable results = graph.evaluateScenarios(scenarios, 0);
+
+    int failed = 0;
+    if (table) {
+        // Only the scenarios go in the table, the other queries are reported on the standard error
+        for (size_t i = 0; i < queries.size(); i++) {
+            if (queries[i].scenario < 0) {
+                cerr << to_string(i + 1) << "\terror\t" << (queries[i].error.empty() ? "not a scenario: " + queries[i].words.front() : queries[i].error) << '\n';
+                failed++;
+            } else if (!results.errors[queries[i].scenario].empty()) {
+                failed++;
+            }
+        }
+        results.write(out);
+        return failed;
+    }
+    for (size_t i = 0; i < queries.size(); i++) {
+        const Query& query = queries[i];
+        string prefix = to_string(i + 1) + '\t' + query.words.front();
+        string error = query.scenario >= 0 ? results.errors[query.scenario] : query.error;
+        if (!error.empty()) {
+            out << to_string(i + 1) << "\terror\t" << error << '\n';
+            failed++;
+            continue;
+        }
+        int rows = 0;
+        const string& command = query.words.front();
+        if (command == "flow") {
+            for (auto node : graph.getNodes()) {
+                auto* city = dynamic_cast<City*>(node);
+                if (city == nullptr || (query.words.size() == 2 && city->getCode() != query.words[1])) {
+                    continue;
+                }
+                double maxFlow = 0;
+                for (const auto& edge : city->getIncomingEdges()) {
+                    maxFlow += edge->getFlow();
+                }
+                out << prefix << '\t' << city->getCode() << '\t' << format(maxFlow) << '\n';
+                rows++;
+            }
+        } else if (command == "reach") {
+            int upstreamNodes = 0;
+            long long maxFlow = graph.maxFlowToCity(query.words[1], upstreamNodes);
+            out << prefix << '\t' << query.words[1] << '\t' << maxFlow << '\t' << upstreamNodes << '\n';
+            rows = 1;
+        } else if (command == "deficit" || command == "totals") {
+            int totalSupply = 0;
+            float totalDemand = 0;
+            auto deficits = graph.WaterDeficit(totalSupply, totalDemand);
+            if (command == "deficit") {
+                for (const auto& pair : deficits) {
+                    out << prefix << '\t' << pair.first->getCode() << '\t' << format(pair.second) << '\n';
+                }
+                rows = (int) deficits.size();
+            } else {
+                double totalDeficit = 0;
+                for (const auto& pair : deficits) {
+                    totalDeficit += pair.second;
+                }
+                out << prefix << '\t' << totalSupply << '\t' << format(totalDemand) << '\t'
+                    << graph.getFlowNetwork().getTotalFlow() << '\t' << format(totalDeficit) << '\n';
+                rows = 1;
+            }
+        } else if (command == "mincut") {
+            list<Edge*> minCut;
+            long long cutCapacity = 0;
+            int cutReservoirs = 0;
+            int cutCities = 0;
+            auto sensitivity = graph.ComputeSensitivity(minCut, cutCapacity, cutReservoirs, cutCities);
+            unordered_map<Edge*, int> gain(sensitivity.begin(), sensitivity.end());
+            for (Edge* edge : minCut) {
+                out << prefix << '\t' << graph.getCode(edge->getOrigin()) << '\t' << graph.getCode(edge->getDest()) << '\t'
+                    << edge->getCapacity() << '\t' << gain[edge] << '\n';
+            }
+            rows = (int) minCut.size();
+        } else if (command == "simulate") {
+            DemandSimulation simulation(graph);
+            int unknownCities = 0;
+            if (!simulation.loadProfiles(query.words[1], unknownCities)) {
+                out << to_string(i + 1) << "\terror\tthe demand profiles couldn't be read: " << query.words[1] << '\n';
+                failed++;
+                continue;
+            }
+            for (const SimulationStep& step : simulation.run()) {
+                out << prefix << '\t' << step.label << '\t' << format(step.demand) << '\t' << step.delivered << '\t'
+                    << format(step.deficit) << '\t' << step.citiesInDeficit << '\n';
+            }
+            rows = simulation.getNumSteps();
+        } else if (command == "cutoff") {
+            string removed = query.words[1];
+            vector<City*> cities;
+            if (query.words.size() == 2) {
+                cities = graph.getCitiesCutOffBy(query.words[1]);
+            } else {
+                removed += '\t' + query.words[2];
+                cities = graph.getCitiesCutOffBy(query.words[1], query.words[2]);
+            }
+            for (City* city : cities) {
+                out << prefix << '\t' << removed << '\t' << city->getCode() << '\n';
+            }
+            rows = (int) cities.size();
+        } else {
+            string changed = query.words[1];
+            if (command == "pipe" || command == "demand") {
+                changed += '\t' + query.words[2];
+            }
+            rows = writeDeficits(prefix + '\t' + changed, results.getDeficits(query.scenario), out);
+        }
+        out << to_string(i + 1) << "\tok\t" << rows << '\n';
+    }
+    return failed;
+}
+
+int BatchQuery::run(int argc, char* argv[]) {
+    string dataset, script, algorithm;
+    bool table = false;
+    for (int i = 2; i < argc; i++) {
+        string arg = argv[i];
+        if (arg == "--algorithm" && i + 1 < argc) {
+            algorithm = argv[++i];
+        } else if (arg == "--table") {
+            table = true;
+        } else if (dataset.empty()) {
+            dataset = arg;
+        } else if (script.empty()) {
+            script = arg;
+        } else {
+            dataset.clear();
+            break;
+        }
+    }
+    if (dataset.empty()) {
+        cerr << "Usage: " << argv[0] << " --batch <large|small|manifest> [script] [--algorithm edmonds-karp|dinic|push-relabel] [--table]\n";
+        return 2;
+    }
+
+    Data data;
+    if (algorithm == "edmonds-karp") {
+        data.setFlowAlgorithm(FlowAlgorithm::EdmondsKarp);
+    } else if (algorithm == "dinic") {
+        data.setFlowAlgorithm(FlowAlgorithm::Dinic);
+    } else if (algorithm == "push-relabel") {
+        data.setFlowAlgorithm(FlowAlgorithm::PushRelabel);
+    } else if (!algorithm.empty()) {
+        cerr << "Unknown max-flow algorithm: " << algorithm << "\n";
+        return 2;
+    }
+    if (dataset == "large") {
+        data.loadData("");
+    } else if (dataset == "small") {
+        data.loadData("_Madeira");
+    } else {
+        DatasetFiles files;
+        if (!Data::readManifest(dataset, files)) {
+            cerr << "The manifest couldn't be read or doesn't list the reservoirs, stations, cities and pipes files: " << dataset << "\n";
+            return 2;
+        }
+        data.loadData(files);
+    }
+    if (data.getWaterNetwork().getNodes().empty()) {
+        cerr << "The dataset couldn't be loaded: " << dataset << "\n";
+        return 2;
+    }
+
+    BatchQuery batch(data);
+    if (script.empty() || script == "-") {
+        return batch.execute(cin, cout, table) == 0 ? 0 : 1;
+    }
+    ifstream file(script);
+    if (!file.is_open()) {
+        cerr << "The script couldn't be opened: " << script << "\n";
+        return 2;
+    }
+    return batch.execute(file, cout, table) == 0 ? 0 : 1;
+}
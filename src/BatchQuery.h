@@ -0,0 +1,116 @@
+#ifndef DA2324_PROJ1_BATCHQUERY_H
+#define DA2324_PROJ1_BATCHQUERY_H
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <unordered_map>
+#include "Data.h"
+#include "DemandSimulation.h"
+
+using namespace std;
+
+/**
+ * @class BatchQuery
+ * @details Answers a script of queries about a loaded dataset without the interactive menus.
+ * @details The max flow is solved once, when the BatchQuery is created, and every query is answered from that solution.
+ * The what-if queries of the script are collected as scenarios and evaluated together with Graph::evaluateScenarios,
+ * warm started from the optimal flow and split between worker threads, so loading and solving are paid once for any
+ * number of queries.
+ * @details A script has one query per line. Empty lines and lines starting with '#' are ignored.
+ * @details flow [city] - Maximum amount of water that reaches the city, or every city
+ * @details reach <city> - Water that could reach the city if it were the only one supplied, and the number of nodes upstream of it
+ * @details deficit - Cities whose demand isn't met, with their deficit
+ * @details totals - Total supply, demand, flow and deficit of the network
+ * @details mincut - Pipes of the minimum cut, with their capacity and the gain in the max flow of one more unit of it
+ * @details simulate <profiles> - Total demand, delivered flow, deficit and cities in deficit at every timestep of a demand profiles file
+ * @details reservoir <code> - Cities in deficit when the reservoir is removed
+ * @details station <code> - Cities in deficit when the pumping station is removed
+ * @details pipe <origin> <destination> - Cities in deficit when the pipe is removed, in both directions if it is bidirectional
+ * @details demand <city> <factor> - Cities in deficit when the demand of the city is multiplied by the factor
+ * @details cutoff <code> | cutoff <origin> <destination> - Cities that lose all of their supply when the node or the pipe
+ * is removed, found without solving. Exact for nodes; for pipes only those behind a bridge of the network are found.
+ * @details Answers are tab-separated rows that start with the number of the query, counting from 1, and its command.
+ * Every query ends with a row "<n> ok <rows>" with the number of rows it wrote, or "<n> error <message>".
+ */
+class BatchQuery {
+private:
+    /**
+     * @details A query of the script
+     */
+    struct Query {
+        /**
+         * @details Command and arguments of the query
+         */
+        vector<string> words;
+        /**
+         * @details Position of its scenario in the scenarios evaluated together, -1 if it has none
+         */
+        int scenario = -1;
+        /**
+         * @details Reason why the query can't be answered, empty if it can
+         */
+        string error;
+    };
+    /**
+     * @details Data with the loaded dataset
+     */
+    Data &data;
+    /**
+     * @details Parses a line of the script. The nodes of the what-if queries are checked when their scenarios are evaluated.
+     * @details Time Complexity: O(L)
+     * @details L is the length of the line.
+     * @param line Line of the script
+     * @param scenarios Scenarios of the script, where the scenario of this query is added
+     * @return The query
+     */
+    Query parse(const string &line, vector<Scenario> &scenarios);
+    /**
+     * @details Writes the rows of a list of cities with their deficit
+     * @details Time Complexity: O(C)
+     * @details C is the number of cities in the list.
+     * @param prefix Number and command of the query, with the code of the removed node or pipe
+     * @param deficits The cities and their deficits
+     * @param out Where the answers are written
+     * @return The number of rows written
+     */
+    static int writeDeficits(const string &prefix, const list<pair<City*, double>> &deficits, ostream &out);
+    /**
+     * @details Formats a number with two decimal places
+     * @details Time Complexity: O(1)
+     * @param value The number
+     * @return The number as a string
+     */
+    static string format(double value);
+public:
+    /**
+     * @details Solves the max flow of the loaded dataset with the selected engine
+     * @details Time Complexity: The one of the selected engine
+     * @param data Data with the loaded dataset
+     */
+    explicit BatchQuery(Data &data);
+    /**
+     * @details Reads a script, evaluates all of its scenarios together and writes the answers in the order of the queries
+     * @details In the table mode only the what-if queries are answered, as a ScenarioTable with a row per query and a
+     * column per city, and the other queries are reported as errors on the standard error.
+     * @details Time Complexity: O(Q + S * |V|^2 * |E| / T) in the worst case, usually much less with warm starts
+     * @details Q is the size of the script, S the number of scenarios, V the number of vertices/nodes, E the number of edges/links and T the number of threads.
+     * @param in Where the script is read from
+     * @param out Where the answers are written
+     * @param table True to write the deficits of the scenarios as one table
+     * @return The number of queries that couldn't be answered
+     */
+    int execute(istream &in, ostream &out, bool table = false);
+    /**
+     * @details Runs the batch mode from the command line
+     * @details Usage: DA2324_Proj1 --batch <large|small|manifest> [script] [--algorithm edmonds-karp|dinic|push-relabel] [--table]
+     * @details The script is read from the given file, or from the standard input if there is none or it is "-".
+     * @details Time Complexity: The one of loading the dataset and of execute
+     * @param argc Number of arguments
+     * @param argv Arguments, starting with --batch
+     * @return 0 if every query was answered, 1 if some couldn't be, 2 if the arguments or the files were invalid
+     */
+    static int run(int argc, char* argv[]);
+};
+
+#endif //DA2324_PROJ1_BATCHQUERY_H
@@ -0,0 +1,105 @@
+#include "CsvReader.h"
+
+#include <algorithm>
+
+CsvField::CsvField(const char* data, size_t size) : data(data), size(size) {}
+
+const char* CsvField::getData() const {
+    return data;
+}
+
+size_t CsvField::getSize() const {
+    return size;
+}
+
+string CsvField::toString() const {
+    return string(data, size);
+}
+
+int CsvField::toInt() const {
+    size_t i = 0;
+    bool negative = false;
+    while (i < size && data[i] == ' ') i++;
+    if (i < size && (data[i] == '-' || data[i] == '+')) {
+        negative = data[i] == '-';
+        i++;
+    }
+    int value = 0;
+    for (; i < size && data[i] >= '0' && data[i] <= '9'; i++) {
+        value = value * 10 + (data[i] - '0');
+    }
+    return negative ? -value : value;
+}
+
+float CsvField::toFloat() const {
+    size_t i = 0;
+    bool negative = false;
+    while (i < size && data[i] == ' ') i++;
+    if (i < size && (data[i] == '-' || data[i] == '+')) {
+        negative = data[i] == '-';
+        i++;
+    }
+    double value = 0;
+    for (; i < size && data[i] >= '0' && data[i] <= '9'; i++) {
+        value = value * 10 + (data[i] - '0');
+    }
+    if (i < size && data[i] == '.') {
+        double scale = 0.1;
+        for (i++; i < size && data[i] >= '0' && data[i] <= '9'; i++) {
+            value += (data[i] - '0') * scale;
+            scale /= 10;
+        }
+    }
+    return (float) (negative ? -value : value);
+}
+
+CsvReader::CsvReader(const string& path) : file(make_shared<MappedFile>(path)) {
+    data = file->getData();
+    size = file->getSize();
+    if (size >= 3 && (unsigned char) data[0] == 0xEF && (unsigned char) data[1] == 0xBB && (unsigned char) data[2] == 0xBF) {
+        position = 3;
+    }
+}
+
+CsvReader::CsvReader(shared_ptr<MappedFile> file, const char* data, size_t size) : file(std::move(file)), data(data), size(size) {}
+
+bool CsvReader::isOpen() const {
+    return data != nullptr;
+}
+
+size_t CsvReader::getSize() const {
+    return size;
+}
+
+vector<CsvReader> CsvReader::split(size_t parts) const {
+    vector<CsvReader> readers;
+    parts = max(parts, (size_t) 1);
+    size_t start = position;
+    for (size_t i = 1; i <= parts && start < size; i++) {
+        size_t end = i == parts ? size : max(start, position + (size - position) / parts * i);
+        while (end < size && data[end] != '\n') end++;
+        end = min(end + 1, size);
+        readers.push_back(CsvReader(file, data + start, end - start));
+        start = end;
+    }
+    return readers;
+}
+
+bool CsvReader::nextRow(vector<CsvField> &fields) {
+    fields.clear();
+    while (position < size && (data[position] == '\n' || data[position] == '\r')) position++;
+    if (position >= size) return false;
+
+    size_t start = position;
+    while (position < size && data[position] != '\n') {
+        if (data[position] == ',') {
+            fields.emplace_back(data + start, position - start);
+            start = position + 1;
+        }
+        position++;
+    }
+    size_t end = position;
+    if (end > start && data[end - 1] == '\r') end--;
+    fields.emplace_back(data + start, end - start);
+    return true;
+}
@@ -0,0 +1,138 @@
+#ifndef DA2324_PROJ1_CSVREADER_H
+#define DA2324_PROJ1_CSVREADER_H
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "MappedFile.h"
+
+using namespace std;
+
+/**
+ * @class CsvField
+ * @details A field of a CSV row, pointing directly into the file's bytes.
+ * @details It is only valid while the CsvReader that produced it is alive.
+ */
+class CsvField {
+private:
+    /**
+     * @details First byte of the field
+     */
+    const char* data;
+    /**
+     * @details Number of bytes of the field
+     */
+    size_t size;
+public:
+    /**
+     * @details Constructor of the CsvField class
+     * @param data First byte of the field
+     * @param size Number of bytes of the field
+     */
+    CsvField(const char* data, size_t size);
+    /**
+     * @details Normal method that returns the first byte of the field
+     * @details Time Complexity: O(1)
+     * @return The first byte of the field
+     */
+    const char* getData() const;
+    /**
+     * @details Normal method that returns the number of bytes of the field
+     * @details Time Complexity: O(1)
+     * @return The number of bytes of the field
+     */
+    size_t getSize() const;
+    /**
+     * @details Copies the field into a string
+     * @details Time Complexity: O(size)
+     * @return The field as a string
+     */
+    string toString() const;
+    /**
+     * @details Parses the field as an integer, stopping at the first character that isn't a digit
+     * @details Time Complexity: O(size)
+     * @return The integer value of the field
+     */
+    int toInt() const;
+    /**
+     * @details Parses the field as a decimal number, like 52.00
+     * @details Time Complexity: O(size)
+     * @return The value of the field
+     */
+    float toFloat() const;
+};
+
+/**
+ * @class CsvReader
+ * @details Reads a CSV file without copying it, by mapping it into memory, and splits its rows into fields.
+ * @details Fields are separated by commas and rows by line breaks, with or without a carriage return. Quoted fields
+ * aren't supported, as none of the data files use them. A UTF-8 byte order mark at the start of the file is skipped.
+ */
+class CsvReader {
+private:
+    /**
+     * @details Mapped file, shared with the readers of its chunks
+     */
+    shared_ptr<MappedFile> file;
+    /**
+     * @details Bytes being read
+     */
+    const char* data = nullptr;
+    /**
+     * @details Number of bytes being read
+     */
+    size_t size = 0;
+    /**
+     * @details Position of the next row
+     */
+    size_t position = 0;
+    /**
+     * @details Creates a reader of a part of a file
+     * @param file Mapped file
+     * @param data First byte of the part
+     * @param size Number of bytes of the part
+     */
+    CsvReader(shared_ptr<MappedFile> file, const char* data, size_t size);
+public:
+    /**
+     * @details Opens and maps the file
+     * @details Time Complexity: O(1), O(N) if the file has to be read into a buffer
+     * @details N is the size of the file
+     * @param path Path of the file
+     */
+    explicit CsvReader(const string& path);
+    /**
+     * @details Checks if the file could be opened
+     * @details Time Complexity: O(1)
+     * @return True - If the file was opened.
+     * @return False - If it couldn't be opened.
+     */
+    bool isOpen() const;
+    /**
+     * @details Normal method that returns the size of the file
+     * @details Time Complexity: O(1)
+     * @return The number of bytes of the file
+     */
+    size_t getSize() const;
+    /**
+     * @details Splits the rows that weren't read yet into parts of about the same size, cut at line breaks, that can be
+     * read by different threads
+     * @details Time Complexity: O(P + L)
+     * @details P is the number of parts and L the length of the longest row
+     * @param parts Number of parts
+     * @return A reader for each part that isn't empty, in the order of the file
+     */
+    vector<CsvReader> split(size_t parts) const;
+    /**
+     * @details Splits the next non-empty row into fields
+     * @details The vector is reused between rows, so after the first rows no memory is allocated
+     * @details Time Complexity: O(L)
+     * @details L is the length of the row
+     * @param fields Fields of the row
+     * @return True - If a row was read.
+     * @return False - If the end of the file was reached.
+     */
+    bool nextRow(vector<CsvField> &fields);
+};
+
+#endif //DA2324_PROJ1_CSVREADER_H
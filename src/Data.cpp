@@ -1,137 +1,344 @@
 #include "Data.h"
 
+#include <sys/stat.h>
+
 Data::Data() : WaterNetwork(Graph()) {}
 
-void Data::readData(const string& extension) {
-    ifstream Reservoirs("../data/Reservoirs" + extension + ".csv");
-    ifstream Stations("../data/Stations" + extension + ".csv");
-    ifstream Cities("../data/Cities" + extension + ".csv");
-    ifstream Pipes("../data/Pipes" + extension + ".csv");
-    string textLine;
+/**
+ * @details Finds when a file was last modified
+ * @param path Path of the file
+ * @param time Time of the last modification
+ * @return True - If the file exists.
+ * @return False - If it doesn't.
+ */
+static bool lastModification(const string& path, time_t &time) {
+    struct stat info{};
+    if (stat(path.c_str(), &info) != 0) {
+        return false;
+    }
+    time = info.st_mtime;
+    return true;
+}
 
-    getline(Reservoirs, textLine);
-    getline(Stations, textLine);
-    getline(Cities, textLine);
-    getline(Pipes, textLine);
+DatasetFiles DatasetFiles::fromExtension(const string& extension) {
+    DatasetFiles files;
+    files.reservoirs = "../data/Reservoirs" + extension + ".csv";
+    files.stations = "../data/Stations" + extension + ".csv";
+    files.cities = "../data/Cities" + extension + ".csv";
+    files.pipes = "../data/Pipes" + extension + ".csv";
+    files.snapshot = "../data/Snapshot" + extension + ".bin";
+    return files;
+}
 
-    while (getline(Reservoirs, textLine)) {
-        stringstream input(textLine);
-        string reservoir, Municipality, Id, Code, MaximumDelivery;
+void Data::loadData(const string& extension) {
+    loadData(DatasetFiles::fromExtension(extension));
+}
 
-        getline(input, reservoir, ',');
-        getline(input, Municipality, ',');
-        getline(input, Id, ',');
-        getline(input, Code, ',');
-        getline(input, MaximumDelivery, '\r');
+void Data::loadData(const DatasetFiles& datasetFiles) {
+    files = datasetFiles;
+    time_t snapshotTime, fileTime;
+    bool fresh = !files.snapshot.empty() && lastModification(files.snapshot, snapshotTime);
+    // A snapshot is only used and written for a complete dataset, so a missing file never goes unnoticed
+    bool complete = true;
+    for (const string& file : {files.reservoirs, files.stations, files.cities, files.pipes}) {
+        if (!lastModification(file, fileTime)) {
+            complete = false;
+        } else if (fresh && fileTime > snapshotTime) {
+            fresh = false;
+        }
+    }
+    if (fresh && complete && readSnapshot(files.snapshot)) {
+        return;
+    }
+    readData(datasetFiles);
+    if (complete) {
+        writeSnapshot(false);
+    }
+}
 
-        WaterNetwork.addNode(Code, new Reservoir(stoi(Id), Code,
-                                             wstringToString(removeAccents(stringToWstring(reservoir))),
-                                             wstringToString(removeAccents(stringToWstring(Municipality))),
-                                             stoi(MaximumDelivery)));
+bool Data::readManifest(const string& path, DatasetFiles &datasetFiles) {
+    ifstream manifest(path);
+    if (!manifest.is_open()) {
+        return false;
+    }
+    size_t slash = path.find_last_of("/\\");
+    string directory = slash == string::npos ? "" : path.substr(0, slash + 1);
+    DatasetFiles result;
+    string textLine;
+    auto trim = [](const string& str) {
+        size_t first = str.find_first_not_of(" \t\r");
+        size_t last = str.find_last_not_of(" \t\r");
+        return first == string::npos ? string() : str.substr(first, last - first + 1);
+    };
+    while (getline(manifest, textLine)) {
+        size_t equals = textLine.find('=');
+        if (textLine.empty() || textLine[0] == '#' || equals == string::npos) {
+            continue;
+        }
+        string key = trim(textLine.substr(0, equals));
+        string value = trim(textLine.substr(equals + 1));
+        if (!value.empty() && value[0] != '/' && value[0] != '\\' && value.find(':') == string::npos) {
+            value = directory + value;
+        }
+        if (key == "reservoirs") result.reservoirs = value;
+        else if (key == "stations") result.stations = value;
+        else if (key == "cities") result.cities = value;
+        else if (key == "pipes") result.pipes = value;
+        else if (key == "snapshot") result.snapshot = value;
+    }
+    if (result.reservoirs.empty() || result.stations.empty() || result.cities.empty() || result.pipes.empty()) {
+        return false;
     }
-    while (getline(Stations, textLine)) {
-        stringstream input(textLine);
-        string Id, Code;
+    datasetFiles = result;
+    return true;
+}
+
+string Data::getSnapshotPath() const {
+    return files.snapshot;
+}
 
-        getline(input, Id, ',');
-        getline(input, Code, '\r');
+bool Data::writeSnapshot(bool withFlows) const {
+    if (files.snapshot.empty() || WaterNetwork.getNodes().empty()) {
+        return false;
+    }
+    FlowExport job;
+    job.snapshotPath = files.snapshot;
+    job.snapshot = Snapshot::encode(WaterNetwork, withFlows);
+    FlowExporter::start(std::move(job));
+    return true;
+}
 
-        WaterNetwork.addNode(Code, new PumpingStation(stoi(Id), Code));
+bool Data::readSnapshot(const string& path) {
+    auto start = chrono::steady_clock::now();
+    bool hasFlows;
+    if (!Snapshot::read(WaterNetwork, path, loadedBytes, loadedRows, hasFlows)) {
+        return false;
     }
-    while (getline(Cities, textLine)) {
-        stringstream input(textLine);
-        string city, Id, Code, Demand, Population;
-        string empty;
+    if (hasFlows && WaterNetwork.restoreFlows()) {
+        snapshotFlowVersion = WaterNetwork.getFlowVersion();
+    }
+    loadedFromSnapshot = true;
+    loadSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    return true;
+}
+
+bool Data::isLoadedFromSnapshot() const {
+    return loadedFromSnapshot;
+}
 
-        getline(input, city, ',');
-        getline(input, Id, ',');
-        getline(input, Code, ',');
-        getline(input, Demand, ',');
-        getline(input, Population, '\r');
+/**
+ * @details Pipe read from a row of the pipes file, pointing into the mapped file
+ */
+struct PipeRow {
+    CsvField origin, dest;
+    int capacity;
+    bool direction;
+};
+
+/**
+ * @details Parses the rows of the reservoirs file
+ * @param reader Reader of the file, after the header
+ * @param parsed The reservoirs, to be copied into the Graph
+ */
+static void parseReservoirs(CsvReader &reader, vector<Reservoir> &parsed) {
+    vector<CsvField> row;
+    while (reader.nextRow(row)) {
+        if (row.size() < 5) continue;
+        string reservoir = row[0].toString(), Municipality = row[1].toString();
+        Data::removeAccents(reservoir);
+        Data::removeAccents(Municipality);
+        parsed.emplace_back(row[2].toInt(), row[3].toString(), reservoir, Municipality, row[4].toInt());
+    }
+}
+
+/**
+ * @details Parses the rows of the stations file
+ * @param reader Reader of the file, after the header
+ * @param parsed The pumping stations, to be copied into the Graph
+ */
+static void parseStations(CsvReader &reader, vector<PumpingStation> &parsed) {
+    vector<CsvField> row;
+    while (reader.nextRow(row)) {
+        if (row.size() < 2) continue;
+        parsed.emplace_back(row[0].toInt(), row[1].toString());
+    }
+}
+
+/**
+ * @details Parses the rows of the cities file
+ * @param reader Reader of the file, after the header
+ * @param parsed The cities, to be copied into the Graph
+ */
+static void parseCities(CsvReader &reader, vector<City> &parsed) {
+    vector<CsvField> row;
+    while (reader.nextRow(row)) {
+        if (row.size() < 5) continue;
+        string city = row[0].toString();
+        Data::removeAccents(city);
+        parsed.emplace_back(row[1].toInt(), row[2].toString(), city, row[3].toFloat(), row[4].toInt());
+    }
+}
 
-        WaterNetwork.addNode(Code, new City(stoi(Id), Code,
-                                            wstringToString(removeAccents(stringToWstring(city))),
-                                            stof(Demand), stoi(Population)));
+/**
+ * @details Parses the rows of a chunk of the pipes file
+ * @param reader Reader of the chunk
+ * @param parsed The pipes
+ */
+static void parsePipes(CsvReader &reader, vector<PipeRow> &parsed) {
+    vector<CsvField> row;
+    while (reader.nextRow(row)) {
+        if (row.size() < 4) continue;
+        parsed.push_back({row[0], row[1], row[2].toInt(), row[3].toInt() != 0});
     }
-    while (getline(Pipes, textLine)) {
-        stringstream input(textLine);
-        string Service_Point_A, Service_Point_B, Capacity, Direction;
+}
+
+void Data::readData(const string& extension) {
+    readData(DatasetFiles::fromExtension(extension));
+}
 
-        getline(input, Service_Point_A, ',');
-        getline(input, Service_Point_B, ',');
-        getline(input, Capacity, ',');
-        getline(input, Direction, '\r');
+void Data::readData(const DatasetFiles& datasetFiles) {
+    auto start = chrono::steady_clock::now();
+    files = datasetFiles;
+    loadedFromSnapshot = false;
+    CsvReader Reservoirs(files.reservoirs);
+    CsvReader Stations(files.stations);
+    CsvReader Cities(files.cities);
+    CsvReader Pipes(files.pipes);
+    vector<CsvField> header;
+    loadedRows = 0;
+    loadedBytes = Reservoirs.getSize() + Stations.getSize() + Cities.getSize() + Pipes.getSize();
+
+    Reservoirs.nextRow(header);
+    Stations.nextRow(header);
+    Cities.nextRow(header);
+    Pipes.nextRow(header);
+
+    // Chunks of about 1 MB, at most one per hardware thread
+    size_t chunks = min((size_t) max(1u, thread::hardware_concurrency()), Pipes.getSize() / (1 << 20) + 1);
+    vector<CsvReader> pipeChunks = Pipes.split(chunks);
+    vector<Reservoir> reservoirs;
+    vector<PumpingStation> stations;
+    vector<City> cities;
+    vector<vector<PipeRow>> pipes(pipeChunks.size());
+    vector<thread> nodeWorkers, pipeWorkers;
+    nodeWorkers.emplace_back(parseReservoirs, ref(Reservoirs), ref(reservoirs));
+    nodeWorkers.emplace_back(parseStations, ref(Stations), ref(stations));
+    parseCities(Cities, cities);
+    for (size_t i = 0; i < pipeChunks.size(); i++) {
+        pipeWorkers.emplace_back(parsePipes, ref(pipeChunks[i]), ref(pipes[i]));
+    }
+    for (auto& worker : nodeWorkers) {
+        worker.join();
+    }
 
-        WaterNetwork.addEdge(Service_Point_A, Service_Point_B, stoi(Capacity), stoi(Direction));
+    for (Reservoir& reservoir : reservoirs) {
+        WaterNetwork.addNode(std::move(reservoir));
     }
-    Reservoirs.close();
-    Stations.close();
-    Cities.close();
-    Pipes.close();
+    for (PumpingStation& station : stations) {
+        WaterNetwork.addNode(std::move(station));
+    }
+    for (City& city : cities) {
+        WaterNetwork.addNode(std::move(city));
+    }
+    loadedRows += (long long) (reservoirs.size() + stations.size() + cities.size());
+    for (size_t i = 0; i < pipeChunks.size(); i++) {
+        pipeWorkers[i].join();
+        for (const PipeRow& pipe : pipes[i]) {
+            WaterNetwork.addEdge(pipe.origin.toString(), pipe.dest.toString(), pipe.capacity, pipe.direction);
+        }
+        loadedRows += (long long) pipes[i].size();
+        vector<PipeRow>().swap(pipes[i]);
+    }
+    loadSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
 }
 
-bool Data::checkIfItExists(const string &code) {
+long long Data::getLoadedRows() const {
+    return loadedRows;
+}
+
+size_t Data::getLoadedBytes() const {
+    return loadedBytes;
+}
+
+double Data::getLoadSeconds() const {
+    return loadSeconds;
+}
+
+bool Data::checkIfItExists(const string &code) const {
     return WaterNetwork.CheckIfNodeExists(code);
 }
 
-Graph Data::getWaterNetwork() {
+Graph& Data::getWaterNetwork() {
     return WaterNetwork;
 }
 
-wstring Data::stringToWstring(const string& str) {
-    wstring_convert<codecvt_utf8_utf16<wchar_t>> converter;
-    return converter.from_bytes(str);
+const Graph& Data::getWaterNetwork() const {
+    return WaterNetwork;
 }
 
-string Data::wstringToString(const wstring& wstr) {
-    wstring_convert<codecvt_utf8_utf16<wchar_t>> converter;
-    return converter.to_bytes(wstr);
+void Data::setFlowAlgorithm(FlowAlgorithm algorithm) {
+    WaterNetwork.setFlowAlgorithm(algorithm);
 }
 
-wstring Data::removeAccents(wstring wstr) {
-    map<wchar_t, wchar_t> accentedChars = {
-            {L'ã', L'a'}, {L'á', L'a'}, {L'à', L'a'}, {L'â', L'a'},
-            {L'ç', L'c'}, {L'é', L'e'}, {L'è', L'e'}, {L'ê', L'e'},
-            {L'í', L'i'}, {L'ì', L'i'}, {L'î', L'i'},
-            {L'õ', L'o'}, {L'ó', L'o'}, {L'ò', L'o'}, {L'ô', L'o'},
-            {L'ú', L'u'}, {L'ù', L'u'}, {L'û', L'u'},
-            {L'Ã', L'A'}, {L'Á', L'A'}, {L'À', L'A'}, {L'Â', L'A'},
-            {L'Ç', L'C'}, {L'É', L'E'}, {L'È', L'E'}, {L'Ê', L'E'},
-            {L'Í', L'I'}, {L'Ì', L'I'}, {L'Î', L'I'},
-            {L'Õ', L'O'}, {L'Ó', L'O'}, {L'Ò', L'O'}, {L'Ô', L'O'},
-            {L'Ú', L'U'}, {L'Ù', L'U'}, {L'Û', L'U'},
-    };
-    for (wchar_t& i : wstr) {
-        if (accentedChars.count(i)) {
-            i = accentedChars[i];
+FlowAlgorithm Data::getFlowAlgorithm() const {
+    return WaterNetwork.getFlowAlgorithm();
+}
+
+/**
+ * @details Letter without the accent of each code point from U+00C0 to U+00FF, 0 for the ones that are kept
+ */
+static const char latin1Folding[64] = {
+        'A', 'A', 'A', 'A', 'A', 'A', 0, 'C', 'E', 'E', 'E', 'E', 'I', 'I', 'I', 'I',
+        'D', 'N', 'O', 'O', 'O', 'O', 'O', 0, 'O', 'U', 'U', 'U', 'U', 'Y', 0, 0,
+        'a', 'a', 'a', 'a', 'a', 'a', 0, 'c', 'e', 'e', 'e', 'e', 'i', 'i', 'i', 'i',
+        'd', 'n', 'o', 'o', 'o', 'o', 'o', 0, 'o', 'u', 'u', 'u', 'u', 'y', 0, 'y',
+};
+
+void Data::removeAccents(string &str) {
+    size_t length = 0;
+    for (size_t i = 0; i < str.size(); i++) {
+        auto byte = (unsigned char) str[i];
+        if (byte == 0xC3 && i + 1 < str.size()) {
+            auto next = (unsigned char) str[i + 1];
+            if (next >= 0x80 && next <= 0xBF && latin1Folding[next - 0x80]) {
+                str[length++] = latin1Folding[next - 0x80];
+                i++;
+                continue;
+            }
         }
+        str[length++] = str[i];
     }
-    return wstr;
+    str.resize(length);
 }
 
-void Data::MaxFlow() {
-    WaterNetwork.edmondsKarp();
+void Data::setBinaryFlowExport(bool enabled) {
+    if (enabled && !binaryFlowExport) {
+        exportedFlowVersion = 0;
+    }
+    binaryFlowExport = enabled;
+}
 
-    ofstream output("../data/FlowGraph.csv");
-    ofstream output2("../data/MaxFlow.csv");
+bool Data::getBinaryFlowExport() const {
+    return binaryFlowExport;
+}
 
-    output << "Source,Destination,Flow\n";
-    output2 << "City,Code,Demand,MaxFlow\n";
+void Data::MaxFlow() {
+    if (!WaterNetwork.isFlowOutdated() && WaterNetwork.getFlowVersion() == exportedFlowVersion) {
+        return;
+    }
+    WaterNetwork.maxFlow();
+    exportedFlowVersion = WaterNetwork.getFlowVersion();
 
-    for (const auto& it : WaterNetwork.getNodes()) {
-        for (const auto e : it.second->getEdges()) {
-            output << e->getOrigin() << "," << e->getDest() << "," << e->getFlow() << "\n";
-        }
-        if (auto* city = dynamic_cast<City*>(it.second)) {
-            int maxFlow = 0;
-            for (const auto e : WaterNetwork.getIncomingEdges(city->getCode())) {
-                if (e->getDest() == city->getCode()) {
-                    maxFlow += e->getFlow();
-                }
-            }
-            output2 << city->getCityName() << "," << city->getCode() << "," << city->getDemand() << "," << maxFlow << "\n";
-        }
+    FlowExport job = FlowExporter::capture(WaterNetwork);
+    job.flowGraphPath = "../data/FlowGraph.csv";
+    job.maxFlowPath = "../data/MaxFlow.csv";
+    if (binaryFlowExport) {
+        job.binaryPath = "../data/Flows.bin";
+    }
+    if (!files.snapshot.empty() && exportedFlowVersion != snapshotFlowVersion) {
+        job.snapshotPath = files.snapshot;
+        job.snapshot = Snapshot::encode(WaterNetwork, true);
+        snapshotFlowVersion = exportedFlowVersion;
     }
-    output.close();
-    output2.close();
+    FlowExporter::start(std::move(job));
 }
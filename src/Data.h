@@ -4,10 +4,34 @@
 #include <fstream>
 #include <sstream>
 #include <iomanip>
-#include <map>
-#include <codecvt>
-#include <locale>
+#include <chrono>
+#include <functional>
 #include "Graph.h"
+#include "CsvReader.h"
+#include "Snapshot.h"
+#include "FlowExporter.h"
+
+/**
+ * @struct DatasetFiles
+ * @details Paths of the files of a dataset
+ */
+struct DatasetFiles {
+    /**
+     * @details Paths of the CSV files with the reservoirs, the pumping stations, the cities and the pipes
+     */
+    string reservoirs, stations, cities, pipes;
+    /**
+     * @details Path of the snapshot of the dataset, empty to never use one
+     */
+    string snapshot;
+    /**
+     * @details Paths of the files of one of the bundled datasets, in ../data
+     * @details Time Complexity - O(1).
+     * @param extension Extension of the files of the dataset, e.g. "_Madeira"
+     * @return The paths of the files
+     */
+    static DatasetFiles fromExtension(const string& extension);
+};
 
 /**
  * @class Data
@@ -16,39 +40,150 @@
 class Data {
 private:
     Graph WaterNetwork;
+    /**
+     * @details Paths of the files of the loaded dataset
+     */
+    DatasetFiles files;
+    /**
+     * @details True if the last dataset was loaded from a snapshot instead of the CSV files
+     */
+    bool loadedFromSnapshot = false;
+    /**
+     * @details True to also write the binary columnar flow file when the max flow is exported
+     */
+    bool binaryFlowExport = false;
+    /**
+     * @details Version of the flows of the WaterNetwork that were last exported, 0 if none were
+     */
+    unsigned long long exportedFlowVersion = 0;
+    /**
+     * @details Version of the flows of the WaterNetwork that are saved in the snapshot, 0 if none are
+     */
+    unsigned long long snapshotFlowVersion = 0;
+    /**
+     * @details Number of rows read by the last call to readData, without the headers
+     */
+    long long loadedRows = 0;
+    /**
+     * @details Number of bytes of the files read by the last call to readData
+     */
+    size_t loadedBytes = 0;
+    /**
+     * @details Time taken by the last call to readData, in seconds
+     */
+    double loadSeconds = 0;
 public:
     /**
      * @details Creates the WaterNetwork.
      * @details Constructor of the Data class.
      */
     Data();
+    /**
+     * @details Loads a dataset, from its snapshot if there is one that is newer than every CSV file, or from the CSV
+     * files otherwise, in which case a snapshot is written in the background for the next time.
+     * @details Time Complexity - O(N).
+     * @details N is the number of nodes and edges of the dataset.
+     * @param extension Extension of the files of the dataset, e.g. "_Madeira"
+     */
+    void loadData(const string& extension);
+    /**
+     * @details Loads a dataset from the given files, using its snapshot if it has one that is newer than every CSV file
+     * @details The snapshot is neither used nor written while a CSV file is missing, nor written for a dataset without nodes.
+     * @details Time Complexity - O(N).
+     * @details N is the number of nodes and edges of the dataset.
+     * @param datasetFiles Paths of the files of the dataset
+     */
+    void loadData(const DatasetFiles& datasetFiles);
+    /**
+     * @details Reads a manifest with the paths of the files of a dataset
+     * @details Each line has the form "key = path", with the keys reservoirs, stations, cities, pipes and, optionally,
+     * snapshot. Empty lines and lines starting with # are ignored, and relative paths are relative to the manifest.
+     * @details Time Complexity - O(N).
+     * @details N is the size of the manifest.
+     * @param path Path of the manifest
+     * @param datasetFiles Paths of the files of the dataset
+     * @return True - If the manifest was read and has the four CSV files.
+     * @return False - If it couldn't be read or a file is missing.
+     */
+    static bool readManifest(const string& path, DatasetFiles &datasetFiles);
+    /**
+     * @details Normal method that returns the path of the snapshot of the loaded dataset
+     * @details Complexity: O(1)
+     * @return The path of the snapshot, empty if the dataset has none
+     */
+    string getSnapshotPath() const;
+    /**
+     * @details Writes a snapshot of the WaterNetwork on the background thread of the FlowExporter
+     * @details Time Complexity - O(|V| + |E|) to encode it, the file is written in the background.
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param withFlows True to also save the flow of every edge
+     * @return True - If the snapshot is being written.
+     * @return False - If the dataset has no snapshot or the WaterNetwork has no nodes.
+     */
+    bool writeSnapshot(bool withFlows) const;
+    /**
+     * @details Reads a snapshot into the WaterNetwork, which must be empty
+     * @details If the snapshot has flows and they are still a max flow of the network, they are kept as its solution, so
+     * the next max flow doesn't solve again.
+     * @details Time Complexity - O(|V| + |E|).
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param path Path of the snapshot
+     * @return True - If the snapshot was read.
+     * @return False - If it is missing, of another version or corrupted.
+     */
+    bool readSnapshot(const string& path);
+    /**
+     * @details Normal method that tells if the last dataset was loaded from a snapshot
+     * @details Complexity: O(1)
+     * @return True - If it was loaded from a snapshot.
+     * @return False - If it was loaded from the CSV files.
+     */
+    bool isLoadedFromSnapshot() const;
     /**
      * @details Reads all the data saved in the files and stores them in the correct structures.
+     * @details The files are memory mapped and split into fields in place by a CsvReader, so only the codes and names
+     * that are kept by the nodes are copied.
      * @details Time Complexity - O(N).
      * @details N is the number of lines in the files to be read.
+     * @param extension Extension of the files of the dataset in ../data, e.g. "_Madeira"
      */
     void readData(const string& extension);
     /**
-     * @details Auxiliary method to convert a string to a wstring
-     * @details Time Complexity- O(1).
-     * @param str String that is to be converted
-     * @return wstring resulting from the conversion
+     * @details Reads the CSV files of a dataset and stores them in the correct structures.
+     * @details The reservoirs, the stations and the cities are parsed concurrently, and so are chunks of the pipes file,
+     * which are added to the graph in order, each as soon as it is parsed and the nodes are in place.
+     * @details Time Complexity - O(N / T) for the parsing, plus O(N) to add the nodes and edges to the graph.
+     * @details N is the number of lines in the files to be read and T the number of hardware threads.
+     * @param datasetFiles Paths of the files of the dataset
      */
-    static wstring stringToWstring(const string& str);
+    void readData(const DatasetFiles& datasetFiles);
     /**
-     * @details Auxiliary method to convert a wstring to a string
-     * @details Time Complexity - O(1).
-     * @param wstr Wstring that is to be converted
-     * @return string resulting from the conversion
+     * @details Normal method that returns the number of rows read by the last call to readData
+     * @details Complexity: O(1)
+     * @return The number of rows, without the headers
      */
-    static string wstringToString(const wstring& wstr);
+    long long getLoadedRows() const;
     /**
-     * @details Auxiliary method to remove accents from a wstring
-     * @details Time Complexity - O(1).
-     * @param wstr Wstring from which the accents are to be removed
-     * @return wstring without accents
+     * @details Normal method that returns the size of the files read by the last call to readData
+     * @details Complexity: O(1)
+     * @return The number of bytes
      */
-    static wstring removeAccents(wstring wstr);
+    size_t getLoadedBytes() const;
+    /**
+     * @details Normal method that returns the time taken by the last call to readData
+     * @details Complexity: O(1)
+     * @return The time in seconds
+     */
+    double getLoadSeconds() const;
+    /**
+     * @details Auxiliary method to remove accents from a UTF-8 string, in place
+     * @details Accented letters of the Latin-1 supplement (U+00C0 to U+00FF) are replaced by the letter without the accent,
+     * using a lookup table indexed by their second byte. Every other byte is kept.
+     * @details Time Complexity - O(N).
+     * @details N is the length of the string.
+     * @param str String from which the accents are to be removed
+     */
+    static void removeAccents(string &str);
     /**
      * @details Checks if Node exists in nodes hash table.
      * @details Time Complexity - O(1).
@@ -56,16 +191,51 @@ public:
      * @return True - If the station exists.
      * @return False - If the station doesn't exist.
      */
-    bool checkIfItExists(const string &code) ;
+    bool checkIfItExists(const string &code) const;
     /**
      * @details Normal method that returns the WaterNetwork
      * @details Complexity: O(1)
      * @return WaterNetwork
      */
-    Graph getWaterNetwork();
+    Graph& getWaterNetwork();
+    /**
+     * @details Normal method that returns a read-only view of the WaterNetwork
+     * @details Complexity: O(1)
+     * @return WaterNetwork
+     */
+    const Graph& getWaterNetwork() const;
+    /**
+     * @details Normal method that sets the max-flow engine used by the WaterNetwork
+     * @details Complexity: O(1)
+     * @param algorithm The max-flow engine
+     */
+    void setFlowAlgorithm(FlowAlgorithm algorithm);
+    /**
+     * @details Normal method that returns the max-flow engine used by the WaterNetwork
+     * @details Complexity: O(1)
+     * @return The max-flow engine
+     */
+    FlowAlgorithm getFlowAlgorithm() const;
+    /**
+     * @details Normal method that sets if the binary columnar flow file, ../data/Flows.bin, is written with the CSV files
+     * @details Complexity: O(1)
+     * @param enabled True to write it
+     */
+    void setBinaryFlowExport(bool enabled);
+    /**
+     * @details Normal method that tells if the binary columnar flow file is written with the CSV files
+     * @details Complexity: O(1)
+     * @return True if it is written
+     */
+    bool getBinaryFlowExport() const;
     /**
-     * @details Calls the EdmondsKarp method from the Graph class and writes the results to two different files
-     * @details Time Complexity: O(|V| * |E|^2)
+     * @details Calls the selected max-flow engine from the Graph class and writes the results to two different files
+     * @details The flows are copied after the solve and the files are formatted and written by a FlowExporter on a
+     * background thread, so this returns as soon as the flow is solved.
+     * @details The snapshot of the dataset is also written again by the FlowExporter, with the flows, unless it already
+     * has them.
+     * @details Nothing is solved or written if the flows that were last exported are still current.
+     * @details Time Complexity: O(1) if the exported flows are current, otherwise O(|V| * |E|^2) with Edmonds-Karp, O(|V|^2 * |E|) with Dinic
      * @details V is the number of vertices/nodes and E is the number of edges/links.
      */
     void MaxFlow();
@@ -0,0 +1,105 @@
+#include "DemandSimulation.h"
+
+DemandSimulation::DemandSimulation(Graph &graph) : graph(graph) {
+    FlowNetwork& network = graph.getFlowNetwork();
+    int sink = network.getSink();
+    for (int a = network.getFirstArc(sink); a < network.getFirstArc(sink + 1); a++) {
+        if (auto* city = dynamic_cast<City*>(network.getNode(network.getHead(a)))) {
+            cities.push_back(city);
+        }
+    }
+}
+
+bool DemandSimulation::loadProfiles(const string &path, int &unknownCities) {
+    unknownCities = 0;
+    CsvReader reader(path);
+    vector<CsvField> row;
+    if (!reader.isOpen() || !reader.nextRow(row) || row.size() < 2) {
+        return false;
+    }
+    labels.clear();
+    for (size_t i = 1; i < row.size(); i++) {
+        labels.push_back(row[i].toString());
+    }
+    vector<float> initial;
+    unordered_map<City*, size_t> column;
+    for (size_t c = 0; c < cities.size(); c++) {
+        initial.push_back(cities[c]->getDemand());
+        column[cities[c]] = c;
+    }
+    demands.assign(labels.size(), initial);
+    while (reader.nextRow(row)) {
+        if (row.empty() || row[0].getSize() == 0) continue;
+        auto it = column.find(dynamic_cast<City*>(graph.getNode(row[0].toString())));
+        if (it == column.end()) {
+            unknownCities++;
+            continue;
+        }
+        for (size_t s = 0; s < labels.size() && s + 1 < row.size(); s++) {
+            if (row[s + 1].getSize() > 0) {
+                demands[s][it->second] = max(0.0f, row[s + 1].toFloat());
+            }
+        }
+    }
+    return true;
+}
+
+int DemandSimulation::getNumSteps() const {
+    return (int) labels.size();
+}
+
+vector<SimulationStep> DemandSimulation::run(bool warmStart) const {
+    vector<SimulationStep> steps;
+    graph.maxFlow();
+    FlowNetwork network = graph.getFlowNetwork();
+
+    // Arc from each city to the super sink, -1 for cities that were removed after the profiles were loaded
+    vector<int> deliveries(cities.size(), -1);
+    for (size_t c = 0; c < cities.size(); c++) {
+        int v = network.getIndex(cities[c]);
+        if (v < 0) {
+            continue;
+        }
+        for (int a = network.getFirstArc(v); a < network.getFirstArc(v + 1); a++) {
+            if (network.getHead(a) == network.getSink()) {
+                deliveries[c] = a;
+            }
+        }
+    }
+
+    vector<pair<int, int>> changes;
+    for (size_t s = 0; s < labels.size(); s++) {
+        changes.clear();
+        for (size_t c = 0; c < cities.size(); c++) {
+            int capacity = FlowNetwork::getDemandCapacity(demands[s][c]);
+            if (deliveries[c] >= 0 && capacity != network.getCapacity(deliveries[c])) {
+                changes.emplace_back(deliveries[c], capacity);
+            }
+        }
+        if (warmStart) {
+            if (!changes.empty()) {
+                network.changeCapacities(changes);
+            }
+        } else {
+            for (const auto& change : changes) {
+                network.setCapacity(change.first, change.second);
+            }
+            network.solve(graph.getFlowAlgorithm());
+        }
+
+        SimulationStep step;
+        step.label = labels[s];
+        step.delivered = network.getTotalFlow();
+        for (size_t c = 0; c < cities.size(); c++) {
+            double demand = demands[s][c];
+            double deficit = demand - (deliveries[c] >= 0 ? network.getFlow(deliveries[c]) : 0);
+            step.demand += demand;
+            if (deficit > 0) {
+                step.deficit += deficit;
+                step.citiesInDeficit++;
+            }
+        }
+        steps.push_back(step);
+    }
+    return steps;
+}
@@ -0,0 +1,98 @@
+#ifndef DA2324_PROJ1_DEMANDSIMULATION_H
+#define DA2324_PROJ1_DEMANDSIMULATION_H
+
+#include <string>
+#include <vector>
+#include "Graph.h"
+#include "CsvReader.h"
+
+using namespace std;
+
+/**
+ * @struct SimulationStep
+ * @details Totals of the max flow at one timestep of a demand simulation
+ */
+struct SimulationStep {
+    /**
+     * @details Label of the timestep, as in the header of the profiles file
+     */
+    string label;
+    /**
+     * @details Total demand of the cities at the timestep
+     */
+    double demand = 0;
+    /**
+     * @details Total flow delivered to the cities
+     */
+    long long delivered = 0;
+    /**
+     * @details Total deficit of the cities
+     */
+    double deficit = 0;
+    /**
+     * @details Number of cities whose demand isn't met
+     */
+    int citiesInDeficit = 0;
+};
+
+/**
+ * @class DemandSimulation
+ * @details Steps the max flow of a network through per-city demand profiles, such as hourly demand curves.
+ * @details A profiles file has a header with a label for each timestep, e.g. "City,00:00,01:00,...", and a row per city
+ * with its code and its demand at each timestep. Cities without a row, and empty or missing values, keep the demand of
+ * the cities file. Flows are whole units, so each city can take up to its demand rounded up.
+ * @details Only the arcs from the cities to the super sink change between timesteps, so each timestep starts from the
+ * max flow of the previous one and only repairs the arcs of the cities whose demand changed, instead of solving again.
+ */
+class DemandSimulation {
+private:
+    /**
+     * @details Graph with the network that is simulated, which isn't changed
+     */
+    Graph &graph;
+    /**
+     * @details Labels of the timesteps
+     */
+    vector<string> labels;
+    /**
+     * @details The cities of the network, in the order of the compiled network
+     */
+    vector<City*> cities;
+    /**
+     * @details Demand of every city at every timestep, indexed by timestep and then by city
+     */
+    vector<vector<float>> demands;
+public:
+    /**
+     * @details Creates a simulation of a Graph without profiles, so every city keeps its demand
+     * @details Time Complexity: O(|V| + |E|) if the network has to be compiled, O(C) otherwise
+     * @details V is the number of vertices/nodes, E is the number of edges/links and C the number of cities.
+     * @param graph The Graph
+     */
+    explicit DemandSimulation(Graph &graph);
+    /**
+     * @details Loads the demand profiles of the cities from a CSV file
+     * @details Time Complexity: O(S * C + N)
+     * @details S is the number of timesteps, C the number of cities and N the size of the file.
+     * @param path Path of the file
+     * @param unknownCities Number of rows whose code isn't a city of the network, which are ignored
+     * @return True if the file was read and has at least one timestep
+     */
+    bool loadProfiles(const string &path, int &unknownCities);
+    /**
+     * @details Normal method that returns the number of timesteps of the loaded profiles
+     * @details Time Complexity: O(1)
+     * @return The number of timesteps
+     */
+    int getNumSteps() const;
+    /**
+     * @details Runs the simulation on a compiled copy of the network, from the max flow with the demands of the cities file
+     * @details Time Complexity: O(S * (C + |V|^2 * |E|)) in the worst case, usually much less with warm starts
+     * @details S is the number of timesteps, C the number of cities, V the number of vertices/nodes and E the number of edges/links.
+     * @param warmStart True to repair the flow of the previous timestep, False to solve every timestep from zero flow
+     * @return The totals of every timestep
+     */
+    vector<SimulationStep> run(bool warmStart = true) const;
+};
+
+#endif //DA2324_PROJ1_DEMANDSIMULATION_H
@@ -1,13 +1,13 @@
 #include "Edge.h"
 
-Edge::Edge(string origin, string dest, int capacity) {
-    this->origin = std::move(origin);
-    this->dest = std::move(dest);
+Edge::Edge(uint32_t origin, uint32_t dest, int capacity) {
+    this->origin = origin;
+    this->dest = dest;
     this->capacity = capacity;
 }
 
-string Edge::getOrigin() const {return origin;}
-string Edge::getDest() const {return dest;}
+uint32_t Edge::getOrigin() const {return origin;}
+uint32_t Edge::getDest() const {return dest;}
 int Edge::getCapacity() const {return capacity;}
 int Edge::getFlow() const {return flow;}
 
@@ -1,6 +1,7 @@
 #ifndef DA2324_PROJ1_EDGE_H
 #define DA2324_PROJ1_EDGE_H
 
+#include <cstdint>
 #include <string>
 #include <utility>
 
@@ -13,13 +14,13 @@ using namespace std;
 class Edge {
 private:
     /**
-     * @brief Origin node's code
+     * @brief Origin node's symbol
      */
-    string origin;
+    uint32_t origin;
     /**
-     * @brief Destination node's code
+     * @brief Destination node's symbol
      */
-    string dest;
+    uint32_t dest;
     /**
      * @brief Capacity of the edge
      */
@@ -31,23 +32,23 @@ private:
 public:
     /**
      * @details Constructor of the Edge class
-     * @param origin Origin node's code
-     * @param dest Destination node's code
+     * @param origin Origin node's symbol
+     * @param dest Destination node's symbol
      * @param capacity Capacity of the edge
      */
-    Edge(string origin, string dest, int capacity);
+    Edge(uint32_t origin, uint32_t dest, int capacity);
     /**
      * @details Normal method that returns the edge's origin
      * @details Time Complexity - O(1).
-     * @return Origin node's code
+     * @return Origin node's symbol, its code is given by Graph::getCode
      */
-    string getOrigin() const;
+    uint32_t getOrigin() const;
     /**
      * @details Normal method that returns the edge's destination
      * @details Time Complexity - O(1).
-     * @return Destination node's code
+     * @return Destination node's symbol, its code is given by Graph::getCode
      */
-    string getDest() const;
+    uint32_t getDest() const;
     /**
      * @details Normal method that returns the edge's capacity
      * @details Time Complexity - O(1).
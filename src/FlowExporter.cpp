@@ -0,0 +1,202 @@
+#include "FlowExporter.h"
+
+/**
+ * @details State shared by the background exports
+ */
+static mutex& exportMutex() {
+    static mutex m;
+    return m;
+}
+static condition_variable& exportDone() {
+    static condition_variable cv;
+    return cv;
+}
+static int runningExports = 0;
+static unsigned long long latestExport = 0;
+/**
+ * @details Latest export that writes each file, so an export only supersedes the earlier writes of the same files
+ */
+static unordered_map<string, unsigned long long> latestWrite;
+
+/**
+ * @details Skips a file that a later export also writes, and otherwise marks the file as written
+ * @param path Path of the file, cleared if it is skipped
+ * @param id The export
+ */
+static void supersede(string &path, unsigned long long id) {
+    if (path.empty()) {
+        return;
+    }
+    // A missing entry means a later export of the file already took its turn
+    auto it = latestWrite.find(path);
+    if (it == latestWrite.end() || it->second != id) {
+        path.clear();
+    } else {
+        latestWrite.erase(it);
+    }
+}
+
+/**
+ * @details Appends an integer to a buffer
+ * @param buffer The buffer
+ * @param value The integer
+ */
+static void appendInt(string &buffer, long long value) {
+    char digits[24];
+    int length = 0;
+    unsigned long long magnitude = value < 0 ? 0ULL - (unsigned long long) value : (unsigned long long) value;
+    do {
+        digits[length++] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude > 0);
+    if (value < 0) {
+        buffer += '-';
+    }
+    while (length > 0) {
+        buffer += digits[--length];
+    }
+}
+
+/**
+ * @details Appends the 32-bit words of a column to a buffer
+ * @param buffer The buffer
+ * @param column The column
+ */
+template <typename T>
+static void appendColumn(string &buffer, const vector<T> &column) {
+    static_assert(sizeof(T) == sizeof(uint32_t), "columns are made of 32-bit words");
+    buffer.append((const char*) column.data(), column.size() * sizeof(T));
+}
+
+/**
+ * @details Writes a buffer to a file at once
+ * @param path Path of the file
+ * @param buffer The buffer
+ */
+static void writeBuffer(const string &path, const string &buffer) {
+    ofstream output(path, ios::binary | ios::trunc);
+    output.write(buffer.data(), (streamsize) buffer.size());
+}
+
+FlowExport FlowExporter::capture(const Graph &graph) {
+    FlowExport job;
+    const vector<Node*>& nodes = graph.getNodes();
+    job.codes.reserve(nodes.size());
+    for (uint32_t symbol = 0; symbol < nodes.size(); symbol++) {
+        job.codes.push_back(graph.getCode(symbol));
+    }
+    vector<int> inflow(nodes.size(), 0);
+    for (auto node : nodes) {
+        if (node == nullptr) {
+            continue;
+        }
+        for (auto e : node->getEdges()) {
+            job.origins.push_back(e->getOrigin());
+            job.dests.push_back(e->getDest());
+            job.flows.push_back(e->getFlow());
+            inflow[e->getDest()] += e->getFlow();
+        }
+    }
+    for (auto node : nodes) {
+        if (auto* city = dynamic_cast<City*>(node)) {
+            job.cities.push_back(city->getSymbol());
+            job.cityNames.push_back(city->getCityName());
+            job.demands.push_back(city->getDemand());
+            job.inflows.push_back(inflow[city->getSymbol()]);
+        }
+    }
+    return job;
+}
+
+void FlowExporter::start(FlowExport job) {
+    static bool registered = false;
+    unsigned long long id;
+    {
+        lock_guard<mutex> lock(exportMutex());
+        if (!registered) {
+            atexit(wait);
+            registered = true;
+        }
+        id = ++latestExport;
+        runningExports++;
+        for (const string* path : {&job.flowGraphPath, &job.maxFlowPath, &job.binaryPath, &job.snapshotPath}) {
+            if (!path->empty()) {
+                latestWrite[*path] = id;
+            }
+        }
+    }
+    thread([](FlowExport job, unsigned long long id) {
+        {
+            lock_guard<mutex> lock(exportMutex());
+            for (string* path : {&job.flowGraphPath, &job.maxFlowPath, &job.binaryPath, &job.snapshotPath}) {
+                supersede(*path, id);
+            }
+        }
+        write(job);
+        lock_guard<mutex> lock(exportMutex());
+        runningExports--;
+        exportDone().notify_all();
+    }, std::move(job), id).detach();
+}
+
+void FlowExporter::wait() {
+    unique_lock<mutex> lock(exportMutex());
+    exportDone().wait(lock, [] { return runningExports == 0; });
+}
+
+void FlowExporter::write(const FlowExport &job) {
+    if (!job.flowGraphPath.empty()) {
+        string buffer = "Source,Destination,Flow\n";
+        buffer.reserve(buffer.size() + job.flows.size() * 24);
+        for (size_t i = 0; i < job.flows.size(); i++) {
+            buffer += job.codes[job.origins[i]];
+            buffer += ',';
+            buffer += job.codes[job.dests[i]];
+            buffer += ',';
+            appendInt(buffer, job.flows[i]);
+            buffer += '\n';
+        }
+        writeBuffer(job.flowGraphPath, buffer);
+    }
+    if (!job.maxFlowPath.empty()) {
+        string buffer = "City,Code,Demand,MaxFlow\n";
+        buffer.reserve(buffer.size() + job.cities.size() * 48);
+        char demand[32];
+        for (size_t i = 0; i < job.cities.size(); i++) {
+            snprintf(demand, sizeof(demand), "%g", job.demands[i]);
+            buffer += job.cityNames[i];
+            buffer += ',';
+            buffer += job.codes[job.cities[i]];
+            buffer += ',';
+            buffer += demand;
+            buffer += ',';
+            appendInt(buffer, job.inflows[i]);
+            buffer += '\n';
+        }
+        writeBuffer(job.maxFlowPath, buffer);
+    }
+    if (!job.binaryPath.empty()) {
+        string pool;
+        vector<uint32_t> offsets;
+        for (const string& code : job.codes) {
+            offsets.push_back((uint32_t) pool.size());
+            pool += code;
+            pool += '\0';
+        }
+        uint32_t header[6] = {Magic, Version, (uint32_t) job.codes.size(), (uint32_t) job.flows.size(),
+                              (uint32_t) job.cities.size(), (uint32_t) pool.size()};
+        string buffer((const char*) header, sizeof(header));
+        appendColumn(buffer, offsets);
+        appendColumn(buffer, job.origins);
+        appendColumn(buffer, job.dests);
+        appendColumn(buffer, job.flows);
+        appendColumn(buffer, job.cities);
+        appendColumn(buffer, job.demands);
+        appendColumn(buffer, job.inflows);
+        buffer += pool;
+        writeBuffer(job.binaryPath, buffer);
+    }
+    if (!job.snapshotPath.empty()) {
+        Snapshot::save(job.snapshotPath, job.snapshot);
+    }
+}
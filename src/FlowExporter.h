@@ -0,0 +1,97 @@
+#ifndef DA2324_PROJ1_FLOWEXPORTER_H
+#define DA2324_PROJ1_FLOWEXPORTER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include "Graph.h"
+#include "Snapshot.h"
+
+using namespace std;
+
+/**
+ * @struct FlowExport
+ * @details Copy of a solved flow, taken so it can be written while the Graph keeps being used
+ */
+struct FlowExport {
+    /**
+     * @details Code of each symbol
+     */
+    vector<string> codes;
+    /**
+     * @details Origin, destination and flow of every edge, in the order of the nodes and of their edges
+     */
+    vector<uint32_t> origins, dests;
+    vector<int> flows;
+    /**
+     * @details Symbol, name, demand and incoming flow of every city
+     */
+    vector<uint32_t> cities;
+    vector<string> cityNames;
+    vector<float> demands;
+    vector<int> inflows;
+    /**
+     * @details Paths of the files to write, an empty path is skipped
+     */
+    string flowGraphPath, maxFlowPath, binaryPath;
+    /**
+     * @details Path of the snapshot of the dataset and its encoded contents, with the flows
+     */
+    string snapshotPath, snapshot;
+};
+
+/**
+ * @class FlowExporter
+ * @details Writes FlowGraph.csv, MaxFlow.csv and, optionally, a binary columnar flow file and the snapshot of the
+ * dataset on a background thread.
+ * @details Each file is formatted into one buffer and written at once. Exports started later supersede the writes of the
+ * same files that haven't been done yet, and the program waits for the running exports before exiting.
+ * @details The binary file holds 32-bit words: magic "DAFL", version, number of symbols, of edges and of cities, and size
+ * of the string pool, then the offset of each code in the pool, the origin, destination and flow columns of the edges,
+ * the symbol, demand (as a float) and incoming flow columns of the cities, and the pool of null-terminated codes.
+ */
+class FlowExporter {
+public:
+    /**
+     * @details First word of the binary flow file, "DAFL" in little-endian
+     */
+    static const uint32_t Magic = 0x4C464144;
+    /**
+     * @details Version of the binary flow file
+     */
+    static const uint32_t Version = 1;
+    /**
+     * @details Copies the flow of every edge of a Graph and the incoming flow of every city
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param graph The Graph, after its flow was solved
+     * @return The copy of the flow
+     */
+    static FlowExport capture(const Graph &graph);
+    /**
+     * @details Writes an export on a background thread and returns immediately
+     * @details Time Complexity: O(1) on the calling thread
+     * @param job The export
+     */
+    static void start(FlowExport job);
+    /**
+     * @details Waits until every export that was started is written
+     * @details Time Complexity: O(1) plus the time left to write them
+     */
+    static void wait();
+    /**
+     * @details Writes an export on the calling thread
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param job The export
+     */
+    static void write(const FlowExport &job);
+};
+
+#endif //DA2324_PROJ1_FLOWEXPORTER_H
@@ -0,0 +1,540 @@
+#include "FlowNetwork.h"
+
+FlowNetwork::FlowNetwork() : source(0), sink(0) {}
+
+FlowNetwork::FlowNetwork(const vector<Node*> &graphNodes, const City* target) {
+    index.assign(graphNodes.size(), -1);
+    for (auto node : graphNodes) {
+        if (node != nullptr) {
+            index[node->getSymbol()] = (int) nodes.size();
+            nodes.push_back(node);
+        }
+    }
+    source = (int) nodes.size();
+    sink = source + 1;
+    nodes.push_back(nullptr);
+    nodes.push_back(nullptr);
+    int n = (int) nodes.size();
+    // Nothing can reach the target city beyond what the reservoirs deliver
+    long long targetCapacity = 0;
+    for (int v = 0; v < source; v++) {
+        if (auto* reservoir = dynamic_cast<Reservoir*>(nodes[v])) {
+            targetCapacity += reservoir->getMaximumDelivery();
+        }
+    }
+    targetCapacity = min(targetCapacity, (long long) numeric_limits<int>::max());
+
+    // Every arc is stored as (tail, head, capacity, edge) and then sorted into place by its tail
+    vector<int> tails, heads, capacities;
+    vector<Edge*> arcEdges;
+    for (int v = 0; v < source; v++) {
+        if (auto* reservoir = dynamic_cast<Reservoir*>(nodes[v])) {
+            tails.push_back(source);
+            heads.push_back(v);
+            capacities.push_back(reservoir->getMaximumDelivery());
+            arcEdges.push_back(nullptr);
+        }
+        auto* city = dynamic_cast<City*>(nodes[v]);
+        if (city != nullptr && (target == nullptr || city == target)) {
+            tails.push_back(v);
+            heads.push_back(sink);
+            capacities.push_back(target == nullptr ? getDemandCapacity(city->getDemand()) : (int) targetCapacity);
+            arcEdges.push_back(nullptr);
+        }
+        for (auto e : nodes[v]->getEdges()) {
+            if (e->getDest() >= index.size() || index[e->getDest()] < 0) {
+                continue;
+            }
+            tails.push_back(v);
+            heads.push_back(index[e->getDest()]);
+            capacities.push_back(e->getCapacity());
+            arcEdges.push_back(e);
+        }
+    }
+
+    int m = (int) tails.size();
+    firstArc.assign(n + 1, 0);
+    for (int i = 0; i < m; i++) {
+        firstArc[tails[i] + 1]++;
+        firstArc[heads[i] + 1]++;
+    }
+    for (int v = 0; v < n; v++) {
+        firstArc[v + 1] += firstArc[v];
+    }
+    vector<int> next(firstArc.begin(), firstArc.end() - 1);
+    head.assign(2 * m, 0);
+    reverse.assign(2 * m, 0);
+    capacity.assign(2 * m, 0);
+    flow.assign(2 * m, 0);
+    edges.assign(2 * m, nullptr);
+    for (int i = 0; i < m; i++) {
+        int a = next[tails[i]]++;
+        int b = next[heads[i]]++;
+        head[a] = heads[i];
+        head[b] = tails[i];
+        reverse[a] = b;
+        reverse[b] = a;
+        capacity[a] = capacities[i];
+        edges[a] = arcEdges[i];
+    }
+    searchQueue.reserve(n);
+    level.assign(n, -1);
+    currentArc.assign(n, 0);
+    parentArc.assign(n, -1);
+    visitedIn.assign(n, 0);
+}
+
+int FlowNetwork::getNumNodes() const {return (int) nodes.size();}
+int FlowNetwork::getSource() const {return source;}
+int FlowNetwork::getSink() const {return sink;}
+
+int FlowNetwork::getDemandCapacity(double demand) {
+    return (int) max(0.0, min(ceil(demand), (double) numeric_limits<int>::max()));
+}
+
+int FlowNetwork::getIndex(Node* node) const {
+    if (node == nullptr || node->getSymbol() >= index.size()) {
+        return -1;
+    }
+    int v = index[node->getSymbol()];
+    return v >= 0 && nodes[v] == node ? v : -1;
+}
+
+int FlowNetwork::getTerminalArc(int v) const {
+    for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+        if (head[a] == sink && capacity[a] > 0) {
+            return a;
+        }
+        if (head[a] == source && capacity[reverse[a]] > 0) {
+            return reverse[a];
+        }
+    }
+    return -1;
+}
+
+vector<int> FlowNetwork::getIncidentArcs(int v) const {
+    vector<int> arcs;
+    for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+        if (capacity[a] > 0) {
+            arcs.push_back(a);
+        }
+        if (capacity[reverse[a]] > 0) {
+            arcs.push_back(reverse[a]);
+        }
+    }
+    return arcs;
+}
+
+Node* FlowNetwork::getNode(int v) const {return nodes[v];}
+int FlowNetwork::getFirstArc(int v) const {return firstArc[v];}
+int FlowNetwork::getNumArcs() const {return (int) head.size();}
+int FlowNetwork::getTail(int a) const {return head[reverse[a]];}
+int FlowNetwork::getHead(int a) const {return head[a];}
+int FlowNetwork::getReverse(int a) const {return reverse[a];}
+Edge* FlowNetwork::getEdge(int a) const {return edges[a];}
+int FlowNetwork::getCapacity(int a) const {return capacity[a];}
+void FlowNetwork::setCapacity(int a, int c) {capacity[a] = c;}
+int FlowNetwork::getFlow(int a) const {return flow[a];}
+const vector<int>& FlowNetwork::getFlows() const {return flow;}
+void FlowNetwork::setFlows(const vector<int> &Flows) {flow = Flows;}
+
+int FlowNetwork::residual(int a) const {return capacity[a] - flow[a];}
+
+void FlowNetwork::push(int a, int f) {
+    flow[a] += f;
+    flow[reverse[a]] -= f;
+}
+
+void FlowNetwork::resetFlows() {
+    fill(flow.begin(), flow.end(), 0);
+}
+
+long long FlowNetwork::getTotalFlow() const {
+    long long total = 0;
+    for (int a = firstArc[source]; a < firstArc[source + 1]; a++) {
+        total += flow[a];
+    }
+    return total;
+}
+
+void FlowNetwork::solve(FlowAlgorithm algorithm) {
+    resetFlows();
+    switch (algorithm) {
+        case FlowAlgorithm::Dinic:
+            dinic();
+            break;
+        case FlowAlgorithm::PushRelabel:
+            pushRelabel();
+            break;
+        case FlowAlgorithm::EdmondsKarp:
+        default:
+            edmondsKarp();
+            break;
+    }
+}
+
+long long FlowNetwork::augment(int from, int to, long long limit, bool throughTerminals) {
+    long long total = 0;
+    while (total < limit && buildLevelGraph(from, to, throughTerminals)) {
+        copy(firstArc.begin(), firstArc.end() - 1, currentArc.begin());
+        while (total < limit) {
+            int pushed = findBlockingFlow(from, to, (int) min(limit - total, (long long) numeric_limits<int>::max()));
+            if (pushed == 0) {
+                break;
+            }
+            total += pushed;
+        }
+    }
+    return total;
+}
+
+void FlowNetwork::disableArc(int a) {
+    changeCapacity(a, 0);
+}
+
+void FlowNetwork::changeCapacity(int a, int c) {
+    changeCapacities({{a, c}});
+}
+
+void FlowNetwork::changeCapacities(const vector<pair<int, int>> &changes) {
+    for (const auto& change : changes) {
+        int a = change.first;
+        int excess = flow[a] - change.second;
+        int u = getTail(a);
+        int v = head[a];
+        capacity[a] = change.second;
+        if (excess > 0 && v == sink) {
+            push(a, -excess);
+            cancelToSource(u, excess);
+        } else if (excess > 0) {
+            push(a, -excess);
+            // u now has the excess too many units and v too few: reroute them first, then cancel the rest
+            long long left = excess - augment(u, v, excess);
+            if (left > 0) {
+                augment(u, source, left);
+                augment(sink, v, left);
+            }
+        }
+    }
+    augment(source, sink, numeric_limits<long long>::max());
+}
+
+long long FlowNetwork::cancelToSource(int v, long long amount) {
+    long long cancelled = 0;
+    while (cancelled < amount) {
+        // Depth-first search from v to the super source over the arcs that bring flow into each node
+        if (++searches == 0) {
+            fill(visitedIn.begin(), visitedIn.end(), 0);
+            searches = 1;
+        }
+        visitedIn[v] = searches;
+        currentArc[v] = firstArc[v];
+        searchQueue.assign(1, v);
+        while (!searchQueue.empty() && searchQueue.back() != source) {
+            int x = searchQueue.back();
+            int& a = currentArc[x];
+            while (a < firstArc[x + 1] && (flow[reverse[a]] <= 0 || visitedIn[head[a]] == searches)) {
+                a++;
+            }
+            if (a == firstArc[x + 1]) {
+                searchQueue.pop_back();
+                continue;
+            }
+            int w = head[a];
+            visitedIn[w] = searches;
+            parentArc[w] = reverse[a];
+            currentArc[w] = firstArc[w];
+            searchQueue.push_back(w);
+        }
+        if (searchQueue.empty()) {
+            break;
+        }
+        // The arcs of the path carry flow from the super source to v
+        long long f = amount - cancelled;
+        for (int x = source; x != v; x = head[parentArc[x]]) {
+            f = min(f, (long long) flow[parentArc[x]]);
+        }
+        for (int x = source; x != v; x = head[parentArc[x]]) {
+            push(parentArc[x], (int) -f);
+        }
+        cancelled += f;
+    }
+    return cancelled;
+}
+
+bool FlowNetwork::rerouteArc(int a) {
+    int f = flow[a];
+    if (f <= 0) {
+        return true;
+    }
+    int u = getTail(a);
+    int v = head[a];
+    int c = capacity[a];
+    push(a, -f);
+    capacity[a] = 0;
+    long long moved = augment(u, v, f, false);
+    capacity[a] = c;
+    if (moved == f) {
+        return true;
+    }
+    // Undo the partial reroute: the paths that were used can be walked back from v to u
+    augment(v, u, moved, false);
+    push(a, f);
+    return false;
+}
+
+vector<bool> FlowNetwork::getSourceSide() const {
+    vector<bool> sourceSide(nodes.size(), false);
+    searchQueue.assign(1, source);
+    sourceSide[source] = true;
+    for (size_t i = 0; i < searchQueue.size(); i++) {
+        int v = searchQueue[i];
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            if (residual(a) > 0 && !sourceSide[head[a]]) {
+                sourceSide[head[a]] = true;
+                searchQueue.push_back(head[a]);
+            }
+        }
+    }
+    return sourceSide;
+}
+
+vector<bool> FlowNetwork::getSinkSide() const {
+    vector<bool> sinkSide(nodes.size(), false);
+    searchQueue.assign(1, sink);
+    sinkSide[sink] = true;
+    for (size_t i = 0; i < searchQueue.size(); i++) {
+        int v = searchQueue[i];
+        // The pair of each arc of v is an arc into v, so the search follows the residual graph backwards
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            if (residual(reverse[a]) > 0 && !sinkSide[head[a]]) {
+                sinkSide[head[a]] = true;
+                searchQueue.push_back(head[a]);
+            }
+        }
+    }
+    return sinkSide;
+}
+
+list<pair<City*, double>> FlowNetwork::getCityDeficits() const {
+    list<pair<City*, double>> deficits;
+    for (int a = firstArc[sink]; a < firstArc[sink + 1]; a++) {
+        auto* city = dynamic_cast<City*>(nodes[head[a]]);
+        double delivered = flow[reverse[a]];
+        if (city != nullptr && delivered < city->getDemand()) {
+            deficits.emplace_back(city, city->getDemand() - delivered);
+        }
+    }
+    return deficits;
+}
+
+void FlowNetwork::writeFlows() const {
+    for (size_t a = 0; a < edges.size(); a++) {
+        if (edges[a] != nullptr) {
+            edges[a]->setFlow(flow[a]);
+        }
+    }
+}
+
+bool FlowNetwork::readFlows() {
+    resetFlows();
+    vector<long long> net(nodes.size(), 0);
+    for (int a = 0; a < (int) edges.size(); a++) {
+        if (edges[a] == nullptr) {
+            continue;
+        }
+        int f = edges[a]->getFlow();
+        if (f < 0 || f > capacity[a]) {
+            return false;
+        }
+        push(a, f);
+        net[getTail(a)] += f;
+        net[head[a]] -= f;
+    }
+    for (int v = 0; v < (int) nodes.size(); v++) {
+        if (v == source || v == sink || net[v] == 0) {
+            continue;
+        }
+        int a = getTerminalArc(v);
+        if (a < 0) {
+            return false;
+        }
+        long long f = getTail(a) == source ? net[v] : -net[v];
+        if (f < 0 || f > capacity[a]) {
+            return false;
+        }
+        push(a, (int) f);
+    }
+    return true;
+}
+
+void FlowNetwork::edmondsKarp() {
+    while (findAugmentingPath()) {
+        int f = numeric_limits<int>::max();
+        for (int v = sink; v != source; v = head[reverse[parentArc[v]]]) {
+            f = min(f, residual(parentArc[v]));
+        }
+        for (int v = sink; v != source; v = head[reverse[parentArc[v]]]) {
+            push(parentArc[v], f);
+        }
+    }
+}
+
+bool FlowNetwork::findAugmentingPath() {
+    fill(parentArc.begin(), parentArc.end(), -1);
+    searchQueue.assign(1, source);
+    parentArc[source] = firstArc[source];
+    for (size_t i = 0; i < searchQueue.size() && parentArc[sink] < 0; i++) {
+        int v = searchQueue[i];
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            if (parentArc[head[a]] < 0 && residual(a) > 0) {
+                parentArc[head[a]] = a;
+                searchQueue.push_back(head[a]);
+            }
+        }
+    }
+    return parentArc[sink] >= 0;
+}
+
+void FlowNetwork::dinic() {
+    augment(source, sink, numeric_limits<long long>::max());
+}
+
+bool FlowNetwork::buildLevelGraph(int from, int to, bool throughTerminals) {
+    fill(level.begin(), level.end(), -1);
+    searchQueue.assign(1, from);
+    level[from] = 0;
+    for (size_t i = 0; i < searchQueue.size() && level[to] < 0; i++) {
+        int v = searchQueue[i];
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            if (!throughTerminals && head[a] != to && (head[a] == source || head[a] == sink)) {
+                continue;
+            }
+            if (residual(a) > 0 && level[head[a]] < 0) {
+                level[head[a]] = level[v] + 1;
+                searchQueue.push_back(head[a]);
+            }
+        }
+    }
+    return level[to] >= 0;
+}
+
+int FlowNetwork::findBlockingFlow(int v, int to, int f) {
+    if (v == to) {
+        return f;
+    }
+    for (int& a = currentArc[v]; a < firstArc[v + 1]; a++) {
+        int w = head[a];
+        if (residual(a) <= 0 || level[w] != level[v] + 1) {
+            continue;
+        }
+        int pushed = findBlockingFlow(w, to, min(f, residual(a)));
+        if (pushed > 0) {
+            push(a, pushed);
+            return pushed;
+        }
+    }
+    return 0;
+}
+
+void FlowNetwork::pushRelabel() {
+    int n = (int) nodes.size();
+    vector<int> height(n);
+    vector<long long> excess(n, 0);
+    copy(firstArc.begin(), firstArc.end() - 1, currentArc.begin());
+    vector<int> count(2 * n + 1, 0);
+    vector<int> active;
+    size_t front = 0;
+    globalRelabel(height, count);
+    for (int a = firstArc[source]; a < firstArc[source + 1]; a++) {
+        int w = head[a];
+        int f = residual(a);
+        if (f > 0) {
+            push(a, f);
+            excess[source] -= f;
+            if (excess[w] == 0 && w != sink) {
+                active.push_back(w);
+            }
+            excess[w] += f;
+        }
+    }
+    int relabels = 0;
+    while (front < active.size()) {
+        int v = active[front++];
+        // Discharge v: push its excess along admissible arcs, relabel when none is left
+        while (excess[v] > 0 && height[v] < 2 * n) {
+            if (currentArc[v] == firstArc[v + 1]) {
+                int oldHeight = height[v];
+                int newHeight = 2 * n;
+                for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+                    if (residual(a) > 0) {
+                        newHeight = min(newHeight, height[head[a]] + 1);
+                    }
+                }
+                count[oldHeight]--;
+                height[v] = newHeight;
+                count[newHeight]++;
+                currentArc[v] = firstArc[v];
+                relabels++;
+                // Gap heuristic: nodes above an empty height can no longer reach the super sink
+                if (count[oldHeight] == 0 && oldHeight < n) {
+                    for (int w = 0; w < n; w++) {
+                        if (height[w] > oldHeight && height[w] < n) {
+                            count[height[w]]--;
+                            height[w] = n + 1;
+                            count[height[w]]++;
+                            currentArc[w] = firstArc[w];
+                        }
+                    }
+                }
+                continue;
+            }
+            int a = currentArc[v];
+            int w = head[a];
+            if (residual(a) > 0 && height[v] == height[w] + 1) {
+                int pushed = (int) min((long long) residual(a), excess[v]);
+                push(a, pushed);
+                excess[v] -= pushed;
+                if (excess[w] == 0 && w != source && w != sink) {
+                    active.push_back(w);
+                }
+                excess[w] += pushed;
+            } else {
+                currentArc[v]++;
+            }
+        }
+        if (relabels >= n) {
+            relabels = 0;
+            globalRelabel(height, count);
+            copy(firstArc.begin(), firstArc.end() - 1, currentArc.begin());
+        }
+        if (front == active.size()) {
+            active.clear();
+            front = 0;
+        }
+    }
+}
+
+void FlowNetwork::globalRelabel(vector<int> &height, vector<int> &count) const {
+    int n = (int) nodes.size();
+    fill(count.begin(), count.end(), 0);
+    fill(height.begin(), height.end(), -1);
+    searchQueue.assign(1, sink);
+    height[sink] = 0;
+    for (size_t i = 0; i < searchQueue.size(); i++) {
+        int v = searchQueue[i];
+        for (int a = firstArc[v]; a < firstArc[v + 1]; a++) {
+            int w = head[a];
+            if (w != source && height[w] < 0 && residual(reverse[a]) > 0) {
+                height[w] = height[v] + 1;
+                searchQueue.push_back(w);
+            }
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        if (height[v] < 0 || v == source) {
+            height[v] = n;
+        }
+        count[height[v]]++;
+    }
+}
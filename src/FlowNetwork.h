@@ -0,0 +1,428 @@
+#ifndef DA2324_PROJ1_FLOWNETWORK_H
+#define DA2324_PROJ1_FLOWNETWORK_H
+
+#include <unordered_map>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <list>
+#include "Node.h"
+
+/**
+ * @enum FlowAlgorithm
+ * @details Max-flow engines that can be used to fill the flow of every Edge in the Graph
+ */
+enum class FlowAlgorithm {
+    EdmondsKarp,
+    Dinic,
+    PushRelabel
+};
+
+/**
+ * @class FlowNetwork
+ * @details Compiled residual graph of the water supply network, used by all the max-flow engines.
+ * @details Nodes are numbered 0..n-1 and the arcs of each node are stored contiguously (compressed sparse row).
+ * @details Every Edge becomes a forward arc paired with a reverse arc, and a super source and a super sink are
+ * connected to every reservoir and from every city with the maximum delivery and the demand as capacities.
+ */
+class FlowNetwork {
+private:
+    /**
+     * @details Node of each index, nullptr for the super source and the super sink
+     */
+    vector<Node*> nodes;
+    /**
+     * @details Index of the Node of each symbol, -1 for symbols without a Node
+     */
+    vector<int> index;
+    /**
+     * @details Index of the first arc of each node, the arcs of node v are [firstArc[v], firstArc[v + 1])
+     */
+    vector<int> firstArc;
+    /**
+     * @details Node that each arc points to
+     */
+    vector<int> head;
+    /**
+     * @details Index of the arc paired with each arc, going in the opposite direction
+     */
+    vector<int> reverse;
+    /**
+     * @details Capacity of each arc, 0 for reverse arcs
+     */
+    vector<int> capacity;
+    /**
+     * @details Flow of each arc, the flow of a reverse arc is always the symmetric of the flow of its pair
+     */
+    vector<int> flow;
+    /**
+     * @details Edge of each forward arc, nullptr for reverse arcs and for the arcs of the super source and sink
+     */
+    vector<Edge*> edges;
+    /**
+     * @details Index of the super source
+     */
+    int source;
+    /**
+     * @details Index of the super sink
+     */
+    int sink;
+    /**
+     * @details Work buffers of the searches, kept between solves so that solving again doesn't allocate memory
+     */
+    mutable vector<int> searchQueue;
+    vector<int> level;
+    vector<int> currentArc;
+    vector<int> parentArc;
+    /**
+     * @details Search in which each node was last visited by cancelToSource, so that no buffer has to be cleared per search
+     */
+    vector<unsigned> visitedIn;
+    unsigned searches = 0;
+public:
+    /**
+     * @details Creates an empty FlowNetwork.
+     */
+    FlowNetwork();
+    /**
+     * @details Compiles the FlowNetwork from the nodes of a Graph
+     * @details Edges to nodes that aren't given are left out, so a FlowNetwork can be compiled from part of a Graph.
+     * @details With a target city, only that city is connected to the super sink, with a capacity that can't limit
+     * the flow, so the max flow is all the water that can reach it.
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param graphNodes The nodes of the Graph, indexed by symbol, nullptr for removed nodes and the ones left out
+     * @param target The only city connected to the super sink, nullptr to connect every city with its demand
+     */
+    explicit FlowNetwork(const vector<Node*> &graphNodes, const City* target = nullptr);
+    /**
+     * @details Capacity of the arc from a city to the super sink for a demand, used by every solve so their results agree
+     * @details Flows are whole units, so the demand is rounded up: a city that gets all its arc can carry isn't short
+     * of a fractional demand.
+     * @details Time Complexity: O(1)
+     * @param demand The demand of the city, e.g. scaled or of a timestep
+     * @return The capacity, from 0 up to the largest int
+     */
+    static int getDemandCapacity(double demand);
+    /**
+     * @details Normal method that returns the number of nodes, including the super source and sink
+     * @details Time Complexity: O(1)
+     * @return The number of nodes
+     */
+    int getNumNodes() const;
+    /**
+     * @details Normal method that returns the index of the super source
+     * @details Time Complexity: O(1)
+     * @return The index of the super source
+     */
+    int getSource() const;
+    /**
+     * @details Normal method that returns the index of the super sink
+     * @details Time Complexity: O(1)
+     * @return The index of the super sink
+     */
+    int getSink() const;
+    /**
+     * @details Normal method that returns the index of a Node
+     * @details Time Complexity: O(1)
+     * @param node The Node
+     * @return The index of the Node, -1 if it isn't part of the network
+     */
+    int getIndex(Node* node) const;
+    /**
+     * @details Normal method that returns the arc from the super source to a reservoir or from a city to the super sink
+     * @details Time Complexity: O(degree)
+     * @param v Index of the reservoir or city
+     * @return The index of the arc, -1 if there is none
+     */
+    int getTerminalArc(int v) const;
+    /**
+     * @details Returns every arc with capacity that starts or ends at a node
+     * @details Time Complexity: O(degree)
+     * @param v Index of the node
+     * @return The indexes of the arcs
+     */
+    vector<int> getIncidentArcs(int v) const;
+    /**
+     * @details Normal method that returns the residual capacity of an arc
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @return How much more flow can go through the arc
+     */
+    int residual(int a) const;
+    /**
+     * @details Pushes flow along an arc, and cancels the same amount on its pair
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @param f Flow to push
+     */
+    void push(int a, int f);
+    /**
+     * @details Normal method that returns the Node of an index
+     * @details Time Complexity: O(1)
+     * @param v Index of the node
+     * @return The Node, nullptr for the super source and sink
+     */
+    Node* getNode(int v) const;
+    /**
+     * @details Normal method that returns the first arc of a node, the arcs of node v are [getFirstArc(v), getFirstArc(v + 1))
+     * @details Time Complexity: O(1)
+     * @param v Index of the node, up to the number of nodes
+     * @return The index of the first arc of the node
+     */
+    int getFirstArc(int v) const;
+    /**
+     * @details Normal method that returns the number of arcs, including the reverse arcs
+     * @details Time Complexity: O(1)
+     * @return The number of arcs
+     */
+    int getNumArcs() const;
+    /**
+     * @details Normal method that returns the node an arc starts at
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @return The index of the tail of the arc
+     */
+    int getTail(int a) const;
+    /**
+     * @details Normal method that returns the node an arc points to
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @return The index of the head of the arc
+     */
+    int getHead(int a) const;
+    /**
+     * @details Normal method that returns the arc paired with an arc
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @return The index of the arc going in the opposite direction
+     */
+    int getReverse(int a) const;
+    /**
+     * @details Normal method that returns the Edge of an arc
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @return The Edge of the arc, nullptr for reverse arcs and for the arcs of the super source and sink
+     */
+    Edge* getEdge(int a) const;
+    /**
+     * @details Normal method that returns the capacity of an arc
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @return The capacity of the arc
+     */
+    int getCapacity(int a) const;
+    /**
+     * @details Normal method that sets the capacity of an arc, without changing its flow
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @param c New capacity of the arc
+     */
+    void setCapacity(int a, int c);
+    /**
+     * @details Normal method that returns the flow of an arc
+     * @details Time Complexity: O(1)
+     * @param a Index of the arc
+     * @return The flow of the arc
+     */
+    int getFlow(int a) const;
+    /**
+     * @details Normal method that returns the flow of every arc
+     * @details Time Complexity: O(1)
+     * @return The flow of every arc
+     */
+    const vector<int>& getFlows() const;
+    /**
+     * @details Normal method that replaces the flow of every arc, e.g. with a previously saved solution
+     * @details Time Complexity: O(|E|)
+     * @details E is the number of edges/links.
+     * @param Flows The flow of every arc
+     */
+    void setFlows(const vector<int> &Flows);
+    /**
+     * @details Sets the flow of every arc to 0
+     * @details Time Complexity: O(|E|)
+     * @details E is the number of edges/links.
+     */
+    void resetFlows();
+    /**
+     * @details Total flow that leaves the super source
+     * @details Time Complexity: O(|R|)
+     * @details R is the number of reservoirs
+     * @return The value of the current flow
+     */
+    long long getTotalFlow() const;
+    /**
+     * @details Finds the maximum flow from the super source to the super sink with the given engine, starting from zero flow
+     * @details Time Complexity: The one of the selected engine
+     * @param algorithm The max-flow engine
+     */
+    void solve(FlowAlgorithm algorithm);
+    /**
+     * @details Pushes as much flow as possible, up to a limit, from one node to another along the residual graph
+     * @details Flow conservation is kept at every other node, so it can be used to move flow inside an existing solution
+     * @details Time Complexity: O(|V|^2 * |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param from Node where the flow starts
+     * @param to Node where the flow ends
+     * @param limit Maximum flow to push
+     * @param throughTerminals False to forbid paths through the super source and the super sink, so the flow delivered to
+     * every city stays the same
+     * @return The flow that was pushed
+     */
+    long long augment(int from, int to, long long limit, bool throughTerminals = true);
+    /**
+     * @details Sets the capacity of an arc to 0 and repairs the current maximum flow incrementally
+     * @details The flow of the arc is first rerouted around it, what can't be rerouted is cancelled back to the super
+     * source and from the super sink, and then the network is augmented again from the repaired flow.
+     * @details Time Complexity: O(|V|^2 * |E|), but usually only a few augmenting paths near the arc are needed
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param a Index of the arc
+     */
+    void disableArc(int a);
+    /**
+     * @details Changes the capacity of an arc and repairs the current maximum flow incrementally
+     * @details When the capacity drops below the flow of the arc, the excess is repaired like in disableArc. In every
+     * case the network is then augmented again from the current flow, which is all a capacity increase needs.
+     * @details Time Complexity: O(|V|^2 * |E|), but usually only a few augmenting paths near the arc are needed
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param a Index of the arc
+     * @param c New capacity of the arc
+     */
+    void changeCapacity(int a, int c);
+    /**
+     * @details Changes the capacities of several arcs and repairs the current maximum flow incrementally
+     * @details Each arc is repaired like in changeCapacity, but the network is only augmented once, after all of them.
+     * @details The arc of a city to the super sink isn't rerouted, because that final augmentation already sends the water
+     * to other cities if it can, so lowering a demand only cancels the excess back along the paths that brought it.
+     * @details Time Complexity: O(|V|^2 * |E|), but usually only a few augmenting paths near the arcs are needed
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param changes The arcs and their new capacities
+     */
+    void changeCapacities(const vector<pair<int, int>> &changes);
+    /**
+     * @details Tries to move all the flow of an arc to other paths between its endpoints, without changing the flow
+     * that leaves the super source or reaches the super sink
+     * @details If it succeeds the arc is left without flow, otherwise the flow is put back on the arc.
+     * @details Time Complexity: O(|V|^2 * |E|), but usually only a few augmenting paths near the arc are needed
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param a Index of the arc
+     * @return True - If the whole flow of the arc was rerouted.
+     * @return False - If it couldn't be rerouted.
+     */
+    bool rerouteArc(int a);
+    /**
+     * @details Find the source side of the minimum cut, the nodes that can be reached from the super source in the residual graph
+     * @details When the flow is maximum, every arc from the source side to the other side is saturated in every maximum flow
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @return True for every node on the source side
+     */
+    vector<bool> getSourceSide() const;
+    /**
+     * @details Find the sink side of the residual graph, the nodes that can still reach the super sink in it
+     * @details When the flow is maximum, one more unit of capacity on an arc from a node of the source side to a node of
+     * the sink side opens an augmenting path, and on any other arc it doesn't change the max flow.
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @return True for every node that can reach the super sink
+     */
+    vector<bool> getSinkSide() const;
+    /**
+     * @details Find the cities whose demand isn't met by the current flow
+     * @details Time Complexity: O(|C|)
+     * @details C is the number of cities
+     * @return The list of cities that have a water deficit, with the respective deficit
+     */
+    list<pair<City*, double>> getCityDeficits() const;
+    /**
+     * @details Copies the flow of every forward arc to its Edge
+     * @details Time Complexity: O(|E|)
+     * @details E is the number of edges/links.
+     */
+    void writeFlows() const;
+    /**
+     * @details Replaces the flow of every arc with the flows of the Edges, the counterpart of writeFlows
+     * @details The flow of the arcs of the super source and sink is the net flow that leaves each reservoir and reaches
+     * each city, so it is rebuilt from the Edges too.
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @return True - If the flows of the Edges are a valid flow of the network.
+     * @return False - If a flow is negative or above a capacity, or a node doesn't conserve flow.
+     */
+    bool readFlows();
+    /**
+     * @details Find the maximum flow using Edmonds-Karp algorithm
+     * @details Time Complexity: O(|V| * |E|^2)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     */
+    void edmondsKarp();
+    /**
+     * @details Find the shortest augmenting path from the super source to the super sink using BFS
+     * @details Time Complexity: O(|V| + |E|)
+     * @details The arc used to reach each node is kept in parentArc, -1 if it wasn't reached
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @return True - If the super sink can be reached.
+     * @return False - If it can't be reached.
+     */
+    bool findAugmentingPath();
+    /**
+     * @details Find the maximum flow using Dinic's algorithm
+     * @details Time Complexity: O(|V|^2 * |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     */
+    void dinic();
+    /**
+     * @details Build the level graph of Dinic's algorithm using BFS over the residual arcs
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @details The distance of every node to the starting node is kept in level, -1 if it can't be reached
+     * @param from Node where the flow starts
+     * @param to Node where the flow ends
+     * @param throughTerminals False to never go through the super source and the super sink
+     * @return True - If the ending node can be reached.
+     * @return False - If it can't be reached.
+     */
+    bool buildLevelGraph(int from, int to, bool throughTerminals);
+    /**
+     * @details Cancels flow that reaches a node, walking back to the super source along arcs that carry flow into it
+     * @details Used when a node is left with more inflow than outflow. Only paths of the current flow are followed, so
+     * each search usually visits a few nodes instead of the whole residual graph.
+     * @details Time Complexity: O(|V| + |E|) per path of the flow that is cancelled
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param v The node
+     * @param amount Flow to cancel
+     * @return The flow that was cancelled
+     */
+    long long cancelToSource(int v, long long amount);
+    /**
+     * @details Push flow from a node to the ending node along the level graph using DFS
+     * @details Each node keeps a pointer to its current arc, so arcs that can't push more flow are never visited again in the same phase
+     * @details Time Complexity: O(|V| * |E|) for all the calls of one phase
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param v Current node
+     * @param to Node where the flow ends
+     * @param f Maximum flow that can reach the current node
+     * @return The flow that was pushed
+     */
+    int findBlockingFlow(int v, int to, int f);
+    /**
+     * @details Find the maximum flow using the FIFO push-relabel algorithm
+     * @details Uses the gap heuristic and a periodic global relabeling of the heights
+     * @details Time Complexity: O(|V|^3)
+     * @details V is the number of vertices/nodes
+     */
+    void pushRelabel();
+    /**
+     * @details Sets the height of every node to its distance to the super sink in the residual graph, using a reverse BFS
+     * @details Nodes that can't reach the super sink get the height |V|, so their excess can only go back to the super source
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param height Height of every node
+     * @param count Number of nodes with each height
+     */
+    void globalRelabel(vector<int> &height, vector<int> &count) const;
+};
+
+#endif //DA2324_PROJ1_FLOWNETWORK_H
@@ -2,158 +2,210 @@
 
 Graph::Graph() = default;
 
-void Graph::addNode(const string& nodeCode, Node* node) {
-    if (nodes.find(nodeCode) == nodes.end()) {
-        nodes[nodeCode] = node;
+void Graph::addEdge(const string &sourceStation, const string &targetStation, int capacity, bool direction) {
+    uint32_t source, target;
+    if (symbols.find(sourceStation, source) && symbols.find(targetStation, target)) {
+        addEdge(source, target, capacity, direction);
     }
 }
 
-void Graph::addEdge(const string &sourceStation, const string &targetStation, int capacity, bool direction) {
-    auto itSrc = nodes.find(sourceStation);
-    auto itTar = nodes.find(targetStation);
-    if (itSrc == nodes.end() || itTar == nodes.end() || itSrc == itTar) {
+void Graph::addEdge(uint32_t sourceStation, uint32_t targetStation, int capacity, bool direction) {
+    if (getNode(sourceStation) == nullptr || getNode(targetStation) == nullptr || sourceStation == targetStation) {
         return;
     }
-    if (direction) {
-        itSrc->second->addEdge(new Edge{sourceStation, targetStation, capacity});
-    } else {
-        itSrc->second->addEdge(new Edge{sourceStation, targetStation, capacity});
-        itTar->second->addEdge(new Edge{targetStation, sourceStation, capacity});
+    addEdge(sourceStation, targetStation, capacity);
+    if (!direction) {
+        addEdge(targetStation, sourceStation, capacity);
     }
 }
 
-void Graph::removeNode(const string& code) {
-    for (auto e : nodes[code]->getEdges()) {
-        nodes[code]->removeEdge(e);
+Edge* Graph::addEdge(uint32_t origin, uint32_t dest, int capacity) {
+    Edge* edge = arena.create<Edge>(origin, dest, capacity);
+    networkOutdated = true;
+    nodes[origin]->addEdge(edge);
+    nodes[dest]->addIncomingEdge(edge);
+    return edge;
+}
+
+void Graph::removeEdge(Edge* edge) {
+    networkOutdated = true;
+    if (Node* dest = getNode(edge->getDest())) {
+        dest->removeIncomingEdge(edge);
+    }
+    nodes[edge->getOrigin()]->removeEdge(edge);
+}
+
+void Graph::removeNode(uint32_t symbol) {
+    Node* node = getNode(symbol);
+    if (node == nullptr) {
+        return;
+    }
+    // removeEdge changes the lists, so they are copied first
+    list<Edge*> edges = node->getEdges(), incomingEdges = node->getIncomingEdges();
+    for (auto e : edges) {
+        removeEdge(e);
     }
-    for (auto e : getIncomingEdges(code)) {
-        nodes[e->getOrigin()]->removeEdge(e);
+    for (auto e : incomingEdges) {
+        removeEdge(e);
     }
-    delete nodes[code];
-    nodes.erase(code);
+    nodes[symbol] = nullptr;
+    networkOutdated = true;
 }
 
 void Graph::setUnvisited() {
-    for (const auto& it : nodes) {
-        it.second->setVisited(false);
+    for (auto node : nodes) {
+        if (node != nullptr) {
+            node->setVisited(false);
+        }
     }
 }
 
-unordered_map<string, Node*> Graph::getNodes() {
+const vector<Node*>& Graph::getNodes() const {
     return nodes;
 }
 
-list<Edge*> Graph::getEdges(const string& code) {
-    return nodes.find(code)->second->getEdges();
+const Arena& Graph::getArena() const {
+    return arena;
 }
 
-list<Edge*> Graph::getIncomingEdges(const string& code) {
-    list<Edge*> incomingEdges;
-    for (const auto& it : nodes) {
-        for (auto e : it.second->getEdges()) {
-            if (e->getDest() == code) {
-                incomingEdges.push_back(e);
-            }
-        }
-    }
-    return incomingEdges;
+Node* Graph::getNode(uint32_t symbol) const {
+    return symbol < nodes.size() ? nodes[symbol] : nullptr;
+}
+
+Node* Graph::getNode(const string& code) const {
+    uint32_t symbol;
+    return symbols.find(code, symbol) ? getNode(symbol) : nullptr;
+}
+
+const string& Graph::getCode(uint32_t symbol) const {
+    return symbols.getCode(symbol);
+}
+
+const list<Edge*>& Graph::getEdges(uint32_t symbol) const {
+    return nodes[symbol]->getEdges();
+}
+
+const list<Edge*>& Graph::getIncomingEdges(uint32_t symbol) const {
+    return nodes[symbol]->getIncomingEdges();
 }
 
-bool Graph::CheckIfNodeExists(const string &code)  {
-    return nodes.find(code) != nodes.end();
+bool Graph::CheckIfNodeExists(const string &code) const {
+    return getNode(code) != nullptr;
 }
 
-void Graph::testAndVisit(queue<Node*> &queue, Edge* edge, Node* node, double residual) {
-    if (!node->getVisited() && residual > 0) {
-        node->setVisited(true);
-        node->setPath(edge);
-        queue.push(node);
+void Graph::setFlowAlgorithm(FlowAlgorithm Algorithm) {
+    if (Algorithm != algorithm) {
+        algorithm = Algorithm;
+        flowOutdated = true;
     }
 }
+FlowAlgorithm Graph::getFlowAlgorithm() const {return algorithm;}
 
-bool Graph::findAugmentingPath(Node* src, Node* dest) {
-    setUnvisited();
-    src->setVisited(true);
-    queue<Node*> q;
-    q.push(src);
-    while (!q.empty() && !dest->getVisited()) {
-        auto v = q.front();
-        q.pop();
-        for (auto e: v->getEdges()) {
-            testAndVisit(q, e, nodes[e->getDest()], e->getCapacity() - e->getFlow());
-        }
-        for (auto e: getIncomingEdges(v->getCode())) {
-            testAndVisit(q, e, nodes[e->getOrigin()], e->getFlow());
-        }
+FlowNetwork& Graph::getFlowNetwork() {
+    if (networkOutdated) {
+        network = FlowNetwork(nodes);
+        networkOutdated = false;
+        flowOutdated = true;
+        supplyIndexOutdated = true;
     }
-    return dest->getVisited();
+    return network;
 }
 
-int Graph::findMinResidualAlongPath(Node* src, Node* dest) {
-    int f = numeric_limits<int>::max();
-    for (auto v = dest; v != src; ) {
-        auto e = v->getPath();
-        if (e->getDest() == v->getCode()) {
-            f = min(f, e->getCapacity() - e->getFlow());
-            v = nodes[e->getOrigin()];
-        }
-        else {
-            f = min(f, e->getFlow());
-            v = nodes[e->getDest()];
-        }
+void Graph::maxFlow() {
+    FlowNetwork& network = getFlowNetwork();
+    if (!flowOutdated) {
+        return;
     }
-    return f;
+    network.solve(algorithm);
+    network.writeFlows();
+    flowOutdated = false;
+    flowVersion++;
 }
 
-void Graph::augmentFlowAlongPath(Node* src, Node* dest, int f) {
-    for (auto v = dest; v != src;) {
-        auto e = v->getPath();
-        if (e->getDest() == v->getCode()) {
-            e->setFlow(e->getFlow() + f);
-            v = nodes[e->getOrigin()];
-        }
-        else {
-            e->setFlow(e->getFlow() - f);
-            v = nodes[e->getDest()];
-        }
+bool Graph::isFlowOutdated() const {
+    return flowOutdated || networkOutdated;
+}
+
+bool Graph::restoreFlows() {
+    FlowNetwork& network = getFlowNetwork();
+    if (!network.readFlows() || network.getSourceSide()[network.getSink()]) {
+        network.resetFlows();
+        flowOutdated = true;
+        return false;
     }
+    flowOutdated = false;
+    flowVersion++;
+    return true;
 }
 
-void Graph::edmondsKarp() {
-    addNode("R_0", new Reservoir(0, "R_0", "superSource", "superSource", numeric_limits<int>::max()));
-    addNode("C_0", new City(0, "C_0", "superSink", numeric_limits<float>::max(), 0));
-    for (auto& it : nodes) {
-        if (auto* reservoir = dynamic_cast<Reservoir*>(it.second)) {
-            addEdge("R_0", it.first, reservoir->getMaximumDelivery(), true);
-        }
-        if (auto* city = dynamic_cast<City*>(it.second)) {
-            addEdge(it.first, "C_0", (int) city->getDemand(), true);
-        }
+unsigned long long Graph::getFlowVersion() const {
+    return flowVersion;
+}
+
+long long Graph::maxFlowToCity(const string &code, int &upstreamNodes) const {
+    auto* city = dynamic_cast<City*>(getNode(code));
+    upstreamNodes = 0;
+    if (city == nullptr) {
+        return -1;
     }
-    setUnvisited();
-    for (const auto& v : nodes) {
-        for (auto e: v.second->getEdges()) {
-            e->setFlow(0);
+    // The subgraph, indexed by symbol, doubles as the visited set of the search
+    vector<Node*> upstream(nodes.size(), nullptr);
+    vector<Node*> queue = {city};
+    upstream[city->getSymbol()] = city;
+    for (size_t i = 0; i < queue.size(); i++) {
+        for (const Edge* edge : queue[i]->getIncomingEdges()) {
+            Node* origin = getNode(edge->getOrigin());
+            if (origin != nullptr && upstream[edge->getOrigin()] == nullptr) {
+                upstream[edge->getOrigin()] = origin;
+                queue.push_back(origin);
+            }
         }
     }
-    while (findAugmentingPath(nodes["R_0"], nodes["C_0"])) {
-        augmentFlowAlongPath(nodes["R_0"], nodes["C_0"], findMinResidualAlongPath(nodes["R_0"], nodes["C_0"]));
+    upstreamNodes = (int) queue.size();
+    FlowNetwork subnetwork(upstream, city);
+    subnetwork.solve(algorithm);
+    return subnetwork.getTotalFlow();
+}
+
+const SupplyIndex& Graph::getSupplyIndex() {
+    FlowNetwork& network = getFlowNetwork();
+    if (supplyIndexOutdated) {
+        supplyIndex = SupplyIndex(network);
+        supplyIndexOutdated = false;
+    }
+    return supplyIndex;
+}
+
+vector<City*> Graph::getCitiesCutOffBy(const string &code) {
+    Node* node = getNode(code);
+    if (node == nullptr) {
+        return {};
     }
-    removeNode("R_0");
-    removeNode("C_0");
+    const SupplyIndex& index = getSupplyIndex();
+    return index.getCitiesCutOffByNode(network.getIndex(node));
 }
 
-list<pair<City*, float>> Graph::WaterDeficit(int &totalSupply, float &totalDemand) {
+vector<City*> Graph::getCitiesCutOffBy(const string &origin, const string &destination) {
+    Node* u = getNode(origin);
+    Node* v = getNode(destination);
+    if (u == nullptr || v == nullptr) {
+        return {};
+    }
+    const SupplyIndex& index = getSupplyIndex();
+    return index.getCitiesCutOffByPipe(network.getIndex(u), network.getIndex(v));
+}
+
+list<pair<City*, float>> Graph::WaterDeficit(int &totalSupply, float &totalDemand) const {
     list<pair<City*, float>> deficit;
-    for (const auto& it : nodes) {
-        if (auto* reservoir = dynamic_cast<Reservoir*>(it.second)) {
+    for (auto node : nodes) {
+        if (auto* reservoir = dynamic_cast<Reservoir*>(node)) {
             totalSupply += reservoir->getMaximumDelivery();
         }
-        if (auto* city = dynamic_cast<City*>(it.second)) {
+        if (auto* city = dynamic_cast<City*>(node)) {
             float demand = city->getDemand();
             totalDemand += demand;
             float maxFlow = 0;
-            for (auto e : getIncomingEdges(city->getCode())) {
+            for (auto e : city->getIncomingEdges()) {
                 maxFlow += (float) e->getFlow();
             }
             if (maxFlow < demand) {
@@ -167,14 +219,17 @@ list<pair<City*, float>> Graph::WaterDeficit(int &totalSupply, float &totalDeman
     return deficit;
 }
 
-list<pair<Edge*, double>> Graph::ComputeMetrics(double &maxDifference, double &averageDifference, double &variance) {
+list<pair<Edge*, double>> Graph::ComputeMetrics(double &maxDifference, double &averageDifference, double &variance) const {
     list<pair<Edge*, double>> metrics;
     double totalDifference = 0;
     int edgeCount = 0;
     double difference;
-    for (const auto& it : nodes) {
-        edgeCount += it.second->getNumEdges();
-        for (Edge* edge : it.second->getEdges()) {
+    for (auto node : nodes) {
+        if (node == nullptr) {
+            continue;
+        }
+        edgeCount += node->getNumEdges();
+        for (Edge* edge : node->getEdges()) {
             difference = edge->getCapacity() - edge->getFlow();
             totalDifference += difference;
             maxDifference = max(maxDifference, difference);
@@ -195,6 +250,39 @@ list<pair<Edge*, double>> Graph::ComputeMetrics(double &maxDifference, double &a
     return metrics;
 }
 
+list<pair<Edge*, int>> Graph::ComputeSensitivity(list<Edge*> &minCut, long long &cutCapacity, int &cutReservoirs, int &cutCities) {
+    list<pair<Edge*, int>> sensitivity;
+    maxFlow();
+    FlowNetwork& network = getFlowNetwork();
+    vector<bool> sourceSide = network.getSourceSide();
+    vector<bool> sinkSide = network.getSinkSide();
+    minCut.clear();
+    cutCapacity = 0;
+    cutReservoirs = 0;
+    cutCities = 0;
+    for (int a = 0; a < network.getNumArcs(); a++) {
+        int u = network.getTail(a);
+        int v = network.getHead(a);
+        if (network.getCapacity(a) <= 0) {
+            continue;
+        }
+        if (sourceSide[u] && !sourceSide[v]) {
+            cutCapacity += network.getCapacity(a);
+            if (network.getEdge(a) != nullptr) {
+                minCut.push_back(network.getEdge(a));
+            } else if (u == network.getSource()) {
+                cutReservoirs++;
+            } else {
+                cutCities++;
+            }
+        }
+        if (network.getEdge(a) != nullptr) {
+            sensitivity.emplace_back(network.getEdge(a), sourceSide[u] && sinkSide[v] ? 1 : 0);
+        }
+    }
+    return sensitivity;
+}
+
 void Graph::balanceLoad(list<pair<Edge*, double>> metrics) {
     // Calculate total excess capacity
     double totalExcessCapacity = 0;
@@ -217,86 +305,398 @@ void Graph::balanceLoad(list<pair<Edge*, double>> metrics) {
             pair.first->setFlow(pair.first->getFlow() + (int) min(flowIncrease, pair.second));
         }
     }
+    flowOutdated = true;
+}
+
+list<pair<City*, double>> Graph::sortByDeficit(list<pair<City*, double>> deficits) {
+    deficits.sort([](const pair<City*, double>& a, const pair<City*, double>& b) {
+        return a.second > b.second;
+    });
+    return deficits;
 }
 
 list<pair<City*, double>> Graph::evaluateReservoirImpact(const string &code) {
-    auto* reservoir = dynamic_cast<Reservoir*>(nodes[code]);
-    list<pair<City*, double>> cities;
-    nodes.erase(code);
-    edmondsKarp();
-    for (const auto& it : nodes) {
-        if (auto* city = dynamic_cast<City*>(it.second)) {
-            double totalIncomingFlow = 0;
-            for (Edge* edge : getIncomingEdges(city->getCode())) {
-                totalIncomingFlow += edge->getFlow();
+    maxFlow();
+    FlowNetwork& network = getFlowNetwork();
+    auto* reservoir = dynamic_cast<Reservoir*>(getNode(code));
+    int v = network.getIndex(reservoir);
+    int arc = v < 0 ? -1 : network.getTerminalArc(v);
+    if (arc < 0 || network.getFlow(arc) == 0) {
+        return sortByDeficit(network.getCityDeficits());
+    }
+    return evaluateRemovals(network, {{arc}}, true, 1).front();
+}
+
+list<pair<City*, double>> Graph::evaluatePumpingStationImpact(const string &code) {
+    maxFlow();
+    FlowNetwork& network = getFlowNetwork();
+    auto* station = dynamic_cast<PumpingStation*>(getNode(code));
+    int v = network.getIndex(station);
+    vector<int> arcs;
+    if (v >= 0) {
+        arcs = network.getIncidentArcs(v);
+    }
+    bool carriesFlow = false;
+    for (int a : arcs) {
+        carriesFlow = carriesFlow || network.getFlow(a) != 0;
+    }
+    if (!carriesFlow) {
+        return sortByDeficit(network.getCityDeficits());
+    }
+    return evaluateRemovals(network, {arcs}, true, 1).front();
+}
+
+unordered_map<Edge*, list<pair<City*, double>>> Graph::evaluatePipelineImpact(bool warmStart, unsigned threads) {
+    int skippedPipes = 0;
+    int solvedPipes = 0;
+    return evaluatePipelineImpact(skippedPipes, solvedPipes, warmStart, threads);
+}
+
+unordered_map<Edge*, list<pair<City*, double>>> Graph::evaluatePipelineImpact(int &skippedPipes, int &solvedPipes, bool warmStart, unsigned threads) {
+    unordered_map<Edge*, list<pair<City*, double>>> impact;
+    maxFlow();
+    FlowNetwork& network = getFlowNetwork();
+    auto baseline = sortByDeficit(network.getCityDeficits());
+    // Pre-pass: a pipeline is non-critical if it has no flow, or if it crosses no minimum cut and its flow can be rerouted
+    FlowNetwork probe = network;
+    vector<bool> sourceSide = network.getSourceSide();
+    vector<vector<int>> removals;
+    skippedPipes = 0;
+    for (int a = 0; a < network.getNumArcs(); a++) {
+        if (network.getEdge(a) == nullptr) {
+            continue;
+        }
+        bool crossesMinCut = sourceSide[network.getTail(a)] && !sourceSide[network.getHead(a)];
+        if (probe.getFlow(a) == 0 || (!crossesMinCut && probe.rerouteArc(a))) {
+            impact[network.getEdge(a)] = baseline;
+            skippedPipes++;
+        } else {
+            removals.push_back({a});
+        }
+    }
+    solvedPipes = (int) removals.size();
+    auto results = evaluateRemovals(network, removals, warmStart, threads);
+    for (size_t i = 0; i < removals.size(); i++) {
+        impact[network.getEdge(removals[i].front())] = results[i];
+    }
+    return impact;
+}
+
+unordered_map<uint32_t, list<pair<City*, double>>> Graph::evaluateAllReservoirsImpact(unsigned threads) {
+    unordered_map<uint32_t, list<pair<City*, double>>> impact;
+    maxFlow();
+    FlowNetwork& network = getFlowNetwork();
+    vector<uint32_t> removed;
+    vector<vector<int>> removals;
+    for (auto node : nodes) {
+        if (dynamic_cast<Reservoir*>(node)) {
+            removed.push_back(node->getSymbol());
+            removals.push_back({network.getTerminalArc(network.getIndex(node))});
+        }
+    }
+    auto results = evaluateRemovals(network, removals, true, threads);
+    for (size_t i = 0; i < removed.size(); i++) {
+        impact[removed[i]] = results[i];
+    }
+    return impact;
+}
+
+unordered_map<uint32_t, list<pair<City*, double>>> Graph::evaluateAllPumpingStationsImpact(unsigned threads) {
+    unordered_map<uint32_t, list<pair<City*, double>>> impact;
+    maxFlow();
+    FlowNetwork& network = getFlowNetwork();
+    vector<uint32_t> removed;
+    vector<vector<int>> removals;
+    for (auto node : nodes) {
+        if (dynamic_cast<PumpingStation*>(node)) {
+            removed.push_back(node->getSymbol());
+            removals.push_back(network.getIncidentArcs(network.getIndex(node)));
+        }
+    }
+    auto results = evaluateRemovals(network, removals, true, threads);
+    for (size_t i = 0; i < removed.size(); i++) {
+        impact[removed[i]] = results[i];
+    }
+    return impact;
+}
+
+list<pair<vector<Edge*>, double>> Graph::evaluateContingencies(int k, double threshold, int maxResults, long long &evaluatedSets, long long &prunedSets) {
+    list<pair<vector<Edge*>, double>> worst;
+    ContingencySearch search;
+    maxFlow();
+    search.network = getFlowNetwork();
+    FlowNetwork& network = search.network;
+    double baselineDeficit = 0;
+    for (const auto& pair : network.getCityDeficits()) {
+        baselineDeficit += pair.second;
+    }
+    for (int a = 0; a < network.getNumArcs(); a++) {
+        if (network.getEdge(a) != nullptr) {
+            search.candidates.push_back(a);
+        }
+    }
+    sort(search.candidates.begin(), search.candidates.end(), [&network](int a, int b) {
+        return network.getFlow(a) > network.getFlow(b);
+    });
+    search.prefix.assign(search.candidates.size() + 1, 0);
+    for (size_t i = 0; i < search.candidates.size(); i++) {
+        search.prefix[i + 1] = search.prefix[i] + network.getFlow(search.candidates[i]);
+    }
+    search.states.resize(k + 1);
+    search.k = k;
+    search.baselineFlow = network.getTotalFlow();
+    search.threshold = threshold;
+    search.maxResults = maxResults;
+    search.evaluatedSets = 0;
+    search.prunedSets = 0;
+    if (k > 0 && k <= (int) search.candidates.size() && maxResults > 0) {
+        searchContingencies(search, 0, 0);
+    }
+    for (const auto& set : search.best) {
+        vector<Edge*> edges;
+        for (int a : set.second) {
+            edges.push_back(network.getEdge(a));
+        }
+        worst.emplace_back(edges, baselineDeficit + (double) set.first);
+    }
+    evaluatedSets = search.evaluatedSets;
+    prunedSets = search.prunedSets;
+    return worst;
+}
+
+void Graph::searchContingencies(ContingencySearch &search, size_t start, long long bound) {
+    FlowNetwork& network = search.network;
+    int depth = (int) search.chosen.size();
+    int remaining = search.k - depth;
+    if (remaining == 0) {
+        search.evaluatedSets++;
+        long long loss = search.baselineFlow - network.getTotalFlow();
+        if ((double) loss > search.threshold) {
+            auto position = search.best.begin();
+            while (position != search.best.end() && position->first >= loss) {
+                position++;
+            }
+            search.best.insert(position, {loss, search.chosen});
+            if ((int) search.best.size() > search.maxResults) {
+                search.best.pop_back();
             }
-            if (totalIncomingFlow < city->getDemand()) {
-                cities.emplace_back(city, (double) city->getDemand() - totalIncomingFlow);
+            if ((int) search.best.size() == search.maxResults) {
+                search.threshold = max(search.threshold, (double) search.best.back().first);
             }
         }
+        return;
+    }
+    search.states[depth] = network.getFlows();
+    size_t n = search.candidates.size();
+    for (size_t i = start; i + remaining <= n; i++) {
+        // Upper bound of the loss: the flow of the chosen pipelines plus the largest flows that can still be chosen
+        if ((double) (bound + search.prefix[i + remaining] - search.prefix[i]) <= search.threshold) {
+            search.prunedSets += countCombinations((long long) (n - i), remaining);
+            break;
+        }
+        int a = search.candidates[i];
+        int capacity = network.getCapacity(a);
+        network.disableArc(a);
+        search.chosen.push_back(a);
+        searchContingencies(search, i + 1, bound + search.prefix[i + 1] - search.prefix[i]);
+        search.chosen.pop_back();
+        network.setCapacity(a, capacity);
+        network.setFlows(search.states[depth]);
     }
-    nodes[code] = reservoir;
-    return cities;
 }
 
-list<pair<City*, double>> Graph::evaluatePumpingStationImpact(const string &code) {
-    auto* station = dynamic_cast<PumpingStation*>(nodes[code]);
-    list<pair<City*, double>> cities;
-    list<Edge> edges;
-    for (Edge* edge : getIncomingEdges(code)) {
-        edges.push_back(*edge);
-    }
-    for (Edge* edge : getIncomingEdges(code)) {
-        nodes[edge->getOrigin()]->removeEdge(edge);
-    }
-    nodes.erase(code);
-    edmondsKarp();
-    for (const auto& it : nodes) {
-        if (auto* city = dynamic_cast<City*>(it.second)) {
-            double totalIncomingFlow = 0;
-            for (Edge* edge : getIncomingEdges(city->getCode())) {
-                totalIncomingFlow += edge->getFlow();
+long long Graph::countCombinations(long long n, int r) {
+    if (r < 0 || r > n) {
+        return 0;
+    }
+    long double combinations = 1;
+    for (int i = 1; i <= r; i++) {
+        combinations = combinations * (long double) (n - r + i) / i;
+    }
+    if (combinations >= (long double) numeric_limits<long long>::max()) {
+        return numeric_limits<long long>::max();
+    }
+    return (long long) (combinations + 0.5);
+}
+
+vector<list<pair<City*, double>>> Graph::evaluateRemovals(const FlowNetwork &network, const vector<vector<int>> &removals, bool warmStart, unsigned threads) const {
+    vector<list<pair<City*, double>>> results(removals.size());
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    threads = (unsigned) min((size_t) threads, max((size_t) 1, removals.size()));
+    auto worker = [&](unsigned t) {
+        FlowNetwork local = network;
+        for (size_t i = t; i < removals.size(); i += threads) {
+            local.setFlows(network.getFlows());
+            for (int a : removals[i]) {
+                if (a < 0) {
+                    continue;
+                }
+                if (warmStart) {
+                    local.disableArc(a);
+                } else {
+                    local.setCapacity(a, 0);
+                }
+            }
+            if (!warmStart) {
+                local.solve(algorithm);
             }
-            if (totalIncomingFlow < city->getDemand()) {
-                cities.emplace_back(city, (double) city->getDemand() - totalIncomingFlow);
+            results[i] = local.getCityDeficits();
+            results[i].sort([](const pair<City*, double>& a, const pair<City*, double>& b) {
+                return a.second > b.second;
+            });
+            for (int a : removals[i]) {
+                if (a >= 0) {
+                    local.setCapacity(a, network.getCapacity(a));
+                }
             }
         }
+    };
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(worker, t);
     }
-    cities.sort([](const pair<City*, double>& a, const pair<City*, double>& b) {
-        return a.second > b.second;
-    });
-    nodes[code] = station;
-    for (const Edge& edge : edges) {
-        nodes[edge.getOrigin()]->addEdge(new Edge(edge));
+    worker(0);
+    for (auto& w : workers) {
+        w.join();
     }
-    return cities;
+    return results;
 }
 
-unordered_map<Edge*, list<pair<City*, double>>> Graph::evaluatePipelineImpact() {
-    unordered_map<Edge*, list<pair<City*, double>>> impact;
-    for (const auto& it : nodes) {
-        for (Edge* edge : it.second->getEdges()) {
-            Edge edgeCopy = *edge;
-            nodes[it.first]->removeEdge(edge);
-            // Run the Edmonds-Karp algorithm
-            edmondsKarp();
-            // Check which cities have their demands not met
-            list<pair<City*, double>> affectedCities;
-            for (const auto& nodePair2 : nodes) {
-                if (auto* city = dynamic_cast<City*>(nodePair2.second)) {
-                    double totalIncomingFlow = 0;
-                    for (Edge* edge2 : getIncomingEdges(city->getCode())) {
-                        totalIncomingFlow += edge2->getFlow();
+bool Graph::getScenarioChanges(const Scenario &scenario, vector<pair<int, int>> &changes, string &error) const {
+    Node* node = getNode(scenario.code);
+    int v = network.getIndex(node);
+    switch (scenario.type) {
+        case ScenarioType::RemoveReservoir:
+            if (!dynamic_cast<Reservoir*>(node)) {
+                error = "not a reservoir: " + scenario.code;
+                return false;
+            }
+            changes.emplace_back(network.getTerminalArc(v), 0);
+            break;
+        case ScenarioType::RemovePumpingStation:
+            if (!dynamic_cast<PumpingStation*>(node)) {
+                error = "not a pumping station: " + scenario.code;
+                return false;
+            }
+            for (int a : network.getIncidentArcs(v)) {
+                changes.emplace_back(a, 0);
+            }
+            break;
+        case ScenarioType::RemovePipe: {
+            int w = network.getIndex(getNode(scenario.destination));
+            if (v >= 0 && w >= 0) {
+                // Forward arcs with an Edge, from the origin to the destination and back
+                for (int a = network.getFirstArc(v); a < network.getFirstArc(v + 1); a++) {
+                    if (network.getHead(a) == w && network.getEdge(a) != nullptr) {
+                        changes.emplace_back(a, 0);
                     }
-                    if (totalIncomingFlow < city->getDemand()) {
-                        affectedCities.emplace_back(city, city->getDemand() - totalIncomingFlow);
+                }
+                for (int a = network.getFirstArc(w); a < network.getFirstArc(w + 1); a++) {
+                    if (network.getHead(a) == v && network.getEdge(a) != nullptr) {
+                        changes.emplace_back(a, 0);
                     }
                 }
             }
-            Edge* edgeCopyPtr = new Edge(edgeCopy);
-            nodes[it.first]->addEdge(edgeCopyPtr);
-            impact[edgeCopyPtr] = affectedCities;
+            if (changes.empty()) {
+                error = "no pipe between " + scenario.code + " and " + scenario.destination;
+                return false;
+            }
+            break;
+        }
+        case ScenarioType::ScaleDemand: {
+            auto* city = dynamic_cast<City*>(node);
+            if (city == nullptr) {
+                error = "not a city: " + scenario.code;
+                return false;
+            }
+            if (!(scenario.factor >= 0)) {
+                error = "the demand factor can't be negative";
+                return false;
+            }
+            int capacity = FlowNetwork::getDemandCapacity((double) city->getDemand() * scenario.factor);
+            for (int a = network.getFirstArc(v); a < network.getFirstArc(v + 1); a++) {
+                if (network.getHead(a) == network.getSink()) {
+                    changes.emplace_back(a, capacity);
+                }
+            }
+            break;
         }
     }
-    return impact;
+    return true;
+}
+
+ScenarioTable Graph::evaluateScenarios(const vector<Scenario> &scenarios, unsigned threads) {
+    ScenarioTable table;
+    maxFlow();
+    FlowNetwork& network = getFlowNetwork();
+
+    // Columns: the cities connected to the super sink, with the arc that delivers their water
+    vector<int> deliveries;
+    vector<int> column(network.getNumNodes(), -1);
+    int sink = network.getSink();
+    for (int a = network.getFirstArc(sink); a < network.getFirstArc(sink + 1); a++) {
+        if (auto* city = dynamic_cast<City*>(network.getNode(network.getHead(a)))) {
+            column[network.getHead(a)] = (int) table.cities.size();
+            table.cities.push_back(city);
+            deliveries.push_back(network.getReverse(a));
+        }
+    }
+    // A scenario is measured against its own demands, so the city whose demand it scales gets the scaled one
+    auto deficitsOf = [&](const FlowNetwork& solved, int scaled, double factor) {
+        vector<double> row(table.cities.size());
+        for (size_t c = 0; c < row.size(); c++) {
+            double demand = table.cities[c]->getDemand() * ((int) c == scaled ? factor : 1);
+            row[c] = max(0.0, demand - solved.getFlow(deliveries[c]));
+        }
+        return row;
+    };
+    table.baseline = deficitsOf(network, -1, 1);
+
+    table.scenarios.resize(scenarios.size());
+    table.errors.resize(scenarios.size());
+    table.deficits.resize(scenarios.size());
+    vector<vector<pair<int, int>>> changes(scenarios.size());
+    vector<int> scaled(scenarios.size(), -1);
+    for (size_t s = 0; s < scenarios.size(); s++) {
+        table.scenarios[s] = scenarios[s].describe();
+        if (getScenarioChanges(scenarios[s], changes[s], table.errors[s]) && scenarios[s].type == ScenarioType::ScaleDemand) {
+            scaled[s] = column[network.getIndex(getNode(scenarios[s].code))];
+        }
+    }
+
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+    threads = (unsigned) min((size_t) threads, max((size_t) 1, scenarios.size()));
+    auto worker = [&](unsigned t) {
+        FlowNetwork local = network;
+        for (size_t s = t; s < scenarios.size(); s += threads) {
+            if (!table.errors[s].empty()) {
+                continue;
+            }
+            local.setFlows(network.getFlows());
+            for (const auto& change : changes[s]) {
+                if (change.first >= 0) {
+                    local.changeCapacity(change.first, change.second);
+                }
+            }
+            table.deficits[s] = deficitsOf(local, scaled[s], scenarios[s].factor);
+            for (const auto& change : changes[s]) {
+                if (change.first >= 0) {
+                    local.setCapacity(change.first, network.getCapacity(change.first));
+                }
+            }
+        }
+    };
+    vector<thread> workers;
+    for (unsigned t = 1; t < threads; t++) {
+        workers.emplace_back(worker, t);
+    }
+    worker(0);
+    for (auto& w : workers) {
+        w.join();
+    }
+    return table;
 }
@@ -8,7 +8,12 @@
 #include <limits>
 #include <memory>
 #include <cmath>
-#include "Node.h"
+#include <thread>
+#include "FlowNetwork.h"
+#include "SymbolTable.h"
+#include "Arena.h"
+#include "SupplyIndex.h"
+#include "Scenario.h"
 
 /**
  * @class Graph
@@ -17,24 +22,145 @@
 class Graph {
 private:
     /**
-     * @details A hash table.
-     * @details When searching the Time Complexity is O(1).
+     * @details Owner of every node and edge of the Graph, which are all freed together when the Graph is destroyed or assigned
      */
-    unordered_map<string, Node*> nodes;
+    Arena arena;
+    /**
+     * @details Symbol of the code of every node that was added to the Graph
+     */
+    SymbolTable symbols;
+    /**
+     * @details Node of each symbol, nullptr if the node was removed.
+     * @details When searching by symbol the Time Complexity is O(1).
+     */
+    vector<Node*> nodes;
+    /**
+     * @details Max-flow engine used by the maxFlow method
+     */
+    FlowAlgorithm algorithm = FlowAlgorithm::EdmondsKarp;
+    /**
+     * @details Compiled residual graph of the network with the super source and sink, reused by every solve
+     */
+    FlowNetwork network;
+    /**
+     * @details True when the Graph changed after the network was compiled, so it has to be compiled again
+     */
+    bool networkOutdated = true;
+    /**
+     * @details True when the flows of the edges may not be the max flow of the current network, because the network
+     * was compiled again, the max-flow engine changed or the flows were redistributed, so the next call to maxFlow solves
+     */
+    bool flowOutdated = true;
+    /**
+     * @details Number of times the max flow was solved, used to tell if a result derived from the flows is still current
+     */
+    unsigned long long flowVersion = 0;
+    /**
+     * @details Dominator tree and bridges of the compiled network, built the first time they are needed after each compile
+     */
+    SupplyIndex supplyIndex;
+    /**
+     * @details True when the network was compiled again after the SupplyIndex was built
+     */
+    bool supplyIndexOutdated = true;
+    /**
+     * @details Sorts a list of cities by deficit, the largest first
+     * @details Time Complexity: O(C * log(C))
+     * @details C is the number of cities in the list.
+     * @param deficits The cities and their deficits
+     * @return The sorted list
+     */
+    static list<pair<City*, double>> sortByDeficit(list<pair<City*, double>> deficits);
+    /**
+     * @details Translates a scenario into the new capacities of the arcs of the compiled network that it changes
+     * @details Time Complexity: O(degree)
+     * @param scenario The scenario
+     * @param changes Where the arcs and their new capacities are added
+     * @param error Why the scenario can't be evaluated, when it can't
+     * @return True if the scenario can be evaluated
+     */
+    bool getScenarioChanges(const Scenario &scenario, vector<pair<int, int>> &changes, string &error) const;
+    /**
+     * @details State of the branch-and-bound search of the N-k contingency analysis
+     */
+    struct ContingencySearch {
+        /**
+         * @details Network where the chosen pipelines are disabled, warm started from the previous level of the search
+         */
+        FlowNetwork network;
+        /**
+         * @details Arcs of the pipelines that can fail, sorted by decreasing flow in the solution without failures
+         */
+        vector<int> candidates;
+        /**
+         * @details Prefix sums of the flows of the candidates
+         */
+        vector<long long> prefix;
+        /**
+         * @details Flow of every arc at each level of the search, used to undo a failure
+         */
+        vector<vector<int>> states;
+        /**
+         * @details Arcs of the pipelines that failed in the current set
+         */
+        vector<int> chosen;
+        /**
+         * @details Number of pipelines that fail together
+         */
+        int k;
+        /**
+         * @details Maximum flow without failures
+         */
+        long long baselineFlow;
+        /**
+         * @details Flow loss that a set must exceed to be reported, raised as the worst sets are found
+         */
+        double threshold;
+        /**
+         * @details Maximum number of sets to report
+         */
+        int maxResults;
+        /**
+         * @details Worst sets found so far with their flow loss, sorted by decreasing loss
+         */
+        vector<pair<long long, vector<int>>> best;
+        /**
+         * @details Number of sets whose flow was solved
+         */
+        long long evaluatedSets;
+        /**
+         * @details Number of sets skipped because their loss couldn't exceed the threshold
+         */
+        long long prunedSets;
+    };
 public:
     /**
      * @details Creates a new Graph.
      * @details Constructor of the Graph class.
      */
     Graph();
+    Graph(const Graph&) = delete;
+    Graph& operator=(const Graph&) = delete;
+    /**
+     * @details Takes the nodes and edges of another Graph. They don't move, so pointers to them stay valid.
+     */
+    Graph(Graph&&) = default;
+    /**
+     * @details Frees the nodes and edges of this Graph and takes the ones of another Graph
+     * @details Time Complexity - O(V + E).
+     * @details V is the number of nodes and E is the number of edges of this Graph.
+     */
+    Graph& operator=(Graph&&) = default;
 
     /**
-     * @details Add a node to the Graph using the node code as a key and the node's information as value.
+     * @details Add a copy of a node to the Graph, interning its code and giving the copy the resulting symbol.
+     * @details The copy is owned by the Graph. Nothing is added if a node with the same code is already in the Graph.
      * @details Time Complexity - O(1).
-     * @param nodeCode The code of the node
      * @param node All of the node's information
+     * @return The node in the Graph, nullptr if its code was already taken
      */
-    void addNode(const string& nodeCode, Node* node);
+    template<typename T>
+    T* addNode(T node);
     /**
      * @details Add an edge from a source station to a target station
      * @details Time Complexity - O(1).
@@ -45,33 +171,84 @@ public:
      */
     void addEdge(const string &sourceStation, const string &targetStation, int capacity, bool direction);
     /**
-     * @details Remove a node from the Graph.
-     * @details Time Complexity - O(|E|).
-     * @details E is the number of edges/links.
-     * @param code The code of the node to remove
+     * @details Add an edge from a source station to a target station, given by their symbols
+     * @details Time Complexity - O(1).
+     * @param sourceStation The symbol of the source station.
+     * @param targetStation The symbol of the target station.
+     * @param capacity Waterway's segment capacity
+     * @param direction Direction of the waterway, true if it is unidirectional, false if it is bidirectional
+     */
+    void addEdge(uint32_t sourceStation, uint32_t targetStation, int capacity, bool direction);
+    /**
+     * @details Remove a node from the Graph, together with its outgoing and incoming edges.
+     * @details Its symbol stays interned, so the symbols of the other nodes don't change. Its memory is only freed with the rest of the Graph.
+     * @details Time Complexity - O(out-degree + in-degree).
+     * @param symbol The symbol of the node to remove
+     */
+    void removeNode(uint32_t symbol);
+    /**
+     * @details Add a single edge to the Graph, as an outgoing edge of its origin and an incoming edge of its destination
+     * @details The edge is owned by the Graph. Both nodes must be in the Graph.
+     * @details Time Complexity - O(1).
+     * @param origin The symbol of the origin node
+     * @param dest The symbol of the destination node
+     * @param capacity Waterway's segment capacity
+     * @return The edge
+     */
+    Edge* addEdge(uint32_t origin, uint32_t dest, int capacity);
+    /**
+     * @details Remove an edge from the Graph. Its memory is only freed with the rest of the Graph.
+     * @details Time Complexity - O(out-degree + in-degree).
+     * @param edge The edge to remove
      */
-    void removeNode(const string& code);
+    void removeEdge(Edge* edge);
     /**
      * @details Normal method that returns the object nodes
      * @details Time Complexity: O(1)
-     * @return The object nodes
+     * @return The node of each symbol, nullptr for the nodes that were removed
+     */
+    const vector<Node*>& getNodes() const;
+    /**
+     * @details Normal method that returns the Arena that owns the nodes and edges, to report the memory they take
+     * @details Time Complexity: O(1)
+     * @return The Arena of the Graph
+     */
+    const Arena& getArena() const;
+    /**
+     * @details Normal method that returns the Node with the given symbol
+     * @details Time Complexity: O(1)
+     * @param symbol Symbol of the Node
+     * @return The Node, nullptr if it doesn't exist
+     */
+    Node* getNode(uint32_t symbol) const;
+    /**
+     * @details Finds the Node with the given code
+     * @details Time Complexity: O(1)
+     * @param code Code of the Node
+     * @return The Node, nullptr if it doesn't exist
      */
-    unordered_map<string, Node*> getNodes();
+    Node* getNode(const string& code) const;
+    /**
+     * @details Normal method that returns the code of a symbol
+     * @details Time Complexity: O(1)
+     * @param symbol Symbol of a Node
+     * @return The code of the Node
+     */
+    const string& getCode(uint32_t symbol) const;
     /**
      * @details Normal method that returns the edges of the provided Node
      * @details Time Complexity: O(1)
-     * @param code Code of the Node to get the edges from
-     * @return The edges of the provided Node
+     * @param symbol Symbol of the Node to get the edges from
+     * @return A read-only view of the edges of the provided Node
      */
-    list<Edge*> getEdges(const string& code);
+    const list<Edge*>& getEdges(uint32_t symbol) const;
     /**
      * @details Normal method that returns the incoming edges of the provided Node
-     * @details Time Complexity: O(|V| * |E|)
-     * @details V is the number of vertices/nodes and E is the number of edges/links.
-     * @param code Code of the Node to get the incoming edges from
-     * @return The incoming edges of the provided Node
+     * @details Time Complexity: O(1)
+     * @param symbol Symbol of the Node to get the incoming edges from
+     * @return A read-only view of the incoming edges of the provided Node
      */
-    list<Edge*> getIncomingEdges(const string& code);
+    const list<Edge*>& getIncomingEdges(uint32_t symbol) const;
      /**
      * @details Checks if a node with the provided code exists in the graph
      * @details Time Complexity - O(1).
@@ -79,7 +256,7 @@ public:
      * @return True - If the station exists.
      * @return False - If the station doesn't exist.
      */
-    bool CheckIfNodeExists(const string& code);
+    bool CheckIfNodeExists(const string& code) const;
     /**
      * @details This function sets all the nodes to unvisited state.
      * @details Time Complexity - O(V).
@@ -87,95 +264,272 @@ public:
      */
     void setUnvisited() ;
     /**
-     * @details Find the maximum flow through the network using Edmonds-Karp algorithm
-     * @details Time Complexity: O(|V| * |E|^²)
+     * @details Normal method that sets the max-flow engine used by the maxFlow method
+     * @details Time Complexity: O(1)
+     * @param Algorithm The max-flow engine
+     */
+    void setFlowAlgorithm(FlowAlgorithm Algorithm);
+    /**
+     * @details Normal method that returns the max-flow engine used by the maxFlow method
+     * @details Time Complexity: O(1)
+     * @return The max-flow engine
+     */
+    FlowAlgorithm getFlowAlgorithm() const;
+    /**
+     * @details Normal method that returns the compiled FlowNetwork of the Graph
+     * @details The network is only compiled again if a node or an edge was added or removed since the last call.
+     * @details Time Complexity: O(1), O(|V| + |E|) when the Graph changed
      * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @return The compiled network
+     */
+    FlowNetwork& getFlowNetwork();
+    /**
+     * @details Find the maximum flow through the network using the selected max-flow engine
+     * @details The compiled FlowNetwork is reset in O(|E|), solved there, and the flows are copied back into the edges
+     * @details The solution is kept until the network or the engine changes or the flows are redistributed, so calling
+     * it again without changes doesn't solve again.
+     * @details Time Complexity: O(1) if the solution is current, the one of the selected engine otherwise
+     */
+    void maxFlow();
+    /**
+     * @details Normal method that tells if the next call to maxFlow has to solve again
+     * @details Time Complexity: O(1)
+     * @return True if the flows of the edges aren't the max flow of the current network
      */
-    void edmondsKarp();
+    bool isFlowOutdated() const;
     /**
-     * @details Find an augmenting path in the graph using BFS
-     * @details Time Complexity: O(|V| + |E| * log(|V|))
-     * @param src Source Node
-     * @param dest Destination Node
-     * @return True - If it is possible.
-     * @return False - If it isn't possible.
+     * @details Takes the flows of the edges, e.g. restored from a snapshot, as the max flow, so maxFlow doesn't solve again
+     * @details The flows are loaded into the compiled FlowNetwork and only kept if they respect the capacities, conserve
+     * flow at every node and leave no augmenting path, otherwise the flow stays outdated.
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @return True - If the flows are a max flow of the network.
+     * @return False - If they aren't.
      */
-    bool findAugmentingPath(Node* src, Node* dest);
+    bool restoreFlows();
     /**
-     * @details Visit a node and add it to the queue
+     * @details Normal method that returns how many times the max flow was solved
+     * @details A result computed from the flows is current while the version and isFlowOutdated don't change
      * @details Time Complexity: O(1)
-     * @param queue Queue of Nodes
-     * @param edge Edge
-     * @param node Node
-     * @param residual Residual capacity
+     * @return The version of the flows of the edges
+     */
+    unsigned long long getFlowVersion() const;
+    /**
+     * @details Find how much water can reach a city if it were the only one supplied, without the global solve
+     * @details The nodes that can reach the city are found by a breadth-first search over the incoming edges, and only
+     * that upstream subgraph is compiled and solved, with the city as the only sink and without limiting it to its demand.
+     * @details Time Complexity: O(|V| + the one of the selected engine on the upstream subgraph)
+     * @details V is the number of vertices/nodes, only to clear the tables indexed by symbol.
+     * @param code The code of the city
+     * @param upstreamNodes Number of nodes that can reach the city, including itself
+     * @return The maximum flow that can reach the city, -1 if the code isn't of a city
+     */
+    long long maxFlowToCity(const string &code, int &upstreamNodes) const;
+    /**
+     * @details Normal method that returns the SupplyIndex of the compiled network, built again if the network changed
+     * @details Time Complexity: O(1), O(|V| + |E|) when the network changed
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @return The index
      */
-    static void testAndVisit(queue<Node*> &queue, Edge* edge, Node* node, double residual);
+    const SupplyIndex& getSupplyIndex();
     /**
-     * @details Find the minimum residual capacity along the augmenting path
-     * @details Time Complexity: O(|V|)
-     * @details V is the number of vertices/nodes
-     * @param src Source Node
-     * @param dest Destination Node
-     * @return The minimum residual capacity
+     * @details Find the cities that lose all of their supply when a reservoir or pumping station is removed, without solving
+     * @details These are the cities that can only be reached from the reservoirs through that node.
+     * @details Time Complexity: O(log C + K), plus building the SupplyIndex if the network changed
+     * @details C is the number of cities and K the number of cities found.
+     * @param code The code of the node
+     * @return The cities, empty if there are none or the code doesn't exist
      */
-    int findMinResidualAlongPath(Node* src, Node* dest);
+    vector<City*> getCitiesCutOffBy(const string &code);
     /**
-     * @details Augment flow along the augmenting path with the given flow value
-     * @details Time Complexity: O(|V|)
-     * @details V is the number of vertices/nodes
-     * @param src Source Node
-     * @param dest Destination Node
-     * @param f Flow value
+     * @details Find cities that lose all of their supply when the pipe between two nodes is removed, in both directions, without solving
+     * @details Only pipes that disconnect the network, its bridges, are detected, so the cities found are a lower bound.
+     * @details Time Complexity: O(log C + K), plus building the SupplyIndex if the network changed
+     * @details C is the number of cities and K the number of cities found.
+     * @param origin The code of one end of the pipe
+     * @param destination The code of the other end of the pipe
+     * @return The cities, empty if none were found or a code doesn't exist
      */
-    void augmentFlowAlongPath(Node* src, Node* dest, int f);
+    vector<City*> getCitiesCutOffBy(const string &origin, const string &destination);
     /**
      * @details Find the cities that have a water deficit
-     * @details Time Complexity: O(|V| * |E|)
+     * @details Time Complexity: O(|V| + |E|)
      * @details V is the number of vertices/nodes and E is the number of edges/links.
      * @param totalSupply Total water supply
      * @param totalDemand Total water demand
      * @return The list of cities that have a water deficit
      */
-    list<pair<City*, float>> WaterDeficit(int &totalSupply, float &totalDemand);
+    list<pair<City*, float>> WaterDeficit(int &totalSupply, float &totalDemand) const;
     /**
      * @details Compute the metrics of the network flow
-     * @details Time Complexity: O(|V| * |E| + |E|)
+     * @details Time Complexity: O(|V| + |E| * log(|E|))
      * @details V is the number of vertices/nodes and E is the number of edges/links.
      * @param maxDifference The maximum difference between the capacity and the flow of all edges
      * @param averageDifference The average difference between the capacity and the flow of all edges
      * @param variance The variance of the difference between the capacity and the flow of all edges
      * @return The list of edges and their respective difference between the capacity and the flow
      */
-    list<pair<Edge *, double>> ComputeMetrics(double &maxDifference, double &averageDifference, double &variance);
+    list<pair<Edge *, double>> ComputeMetrics(double &maxDifference, double &averageDifference, double &variance) const;
+    /**
+     * @details Find the minimum cut that binds the max flow and how much each pipe limits it, from the final residual graph
+     * @details The cut is the one closest to the reservoirs: the saturated arcs that leave the nodes the super source can
+     * still reach. Its arcs are pipes, reservoirs delivering their maximum and cities that get all of their demand.
+     * @details One more unit of capacity on a pipe raises the max flow by one exactly when the super source can reach its
+     * origin and its destination can reach the super sink in the residual graph, so two searches give the gain of every pipe.
+     * @details Time Complexity: O(|V| + |E|), plus solving if the max flow isn't current
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param minCut The pipes in the minimum cut
+     * @param cutCapacity Capacity of the minimum cut, which is the max flow
+     * @param cutReservoirs Number of reservoirs in the minimum cut
+     * @param cutCities Number of cities in the minimum cut
+     * @return Every pipe with the gain in the max flow of one more unit of its capacity, 0 or 1
+     */
+    list<pair<Edge*, int>> ComputeSensitivity(list<Edge*> &minCut, long long &cutCapacity, int &cutReservoirs, int &cutCities);
     /**
      * @details Redistribute the flow in the network
+     * @details The redistributed flows aren't a max flow, so the next call to maxFlow solves again
      * @details Time Complexity: O(|C| * |E|)
      * @details C is the number of cities and E is the number of edges/links.
      */
     void balanceLoad(list<pair<Edge *, double>> list);
     /**
      * @details Find the cities that were affected by the removal of the reservoir with the given code
-     * @details Time Complexity: O(|V| * |E|)
-     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @details The removal is evaluated on a compiled copy of the network, warm started from the optimal flow, so the Graph isn't changed
+     * @details A reservoir that delivers no water in the optimal flow has no impact, so the cities in deficit are returned without a copy.
+     * @details Time Complexity: O(|V|^2 * |E|), O(C * log(C)) if the reservoir delivers no water
+     * @details V is the number of vertices/nodes, E is the number of edges/links and C the number of cities.
      * @param code The code of the reservoir to remove
-     * @return The list of cities that were affected by the reservoir removal, with the respective impact
+     * @return The list of cities that were affected by the reservoir removal, with the respective impact, or the cities
+     * in deficit without any removal if the code isn't of a reservoir
      */
     list<pair<City*, double>> evaluateReservoirImpact(const string &code);
     /**
      * @details Find the cities that were affected by the removal of the pumping station with the given code
-     * @details Time Complexity: O(|V| * |E|)
-     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @details The removal is evaluated on a compiled copy of the network, warm started from the optimal flow, so the Graph isn't changed
+     * @details A station that no water goes through in the optimal flow has no impact, so the cities in deficit are returned without a copy.
+     * @details Time Complexity: O(|V|^2 * |E|), O(C * log(C)) if no water goes through the station
+     * @details V is the number of vertices/nodes, E is the number of edges/links and C the number of cities.
      * @param code The code of the pumping station to remove
-     * @return The list of cities that were affected by the pumping station removal, with the respective impact
+     * @return The list of cities that were affected by the pumping station removal, with the respective impact, or the
+     * cities in deficit without any removal if the code isn't of a pumping station
      */
     list<pair<City *, double>> evaluatePumpingStationImpact(const string &code);
     /**
      * @details Find the cities that were affected by the removal of a pipeline
-     * @details Time Complexity: O(|V|^2 * |E|^2)
-     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @details The network is compiled and solved once. In the incremental mode each pipeline removal starts from that
+     * optimal flow, cancels only the flow that went through the removed pipeline and augments again locally.
+     * @details The removals are independent, so they are split between worker threads that each own a copy of the network.
+     * @details The Graph isn't changed, and its edges keep the flow of the solution without removals.
+     * @details Time Complexity: O(|E| * |V|^2 * |E| / T) in the worst case, usually much less with warm starts
+     * @details V is the number of vertices/nodes, E is the number of edges/links and T the number of threads.
+     * @param warmStart True to repair the optimal flow incrementally, False to solve from zero flow for every pipeline
+     * @param threads Number of worker threads, 0 to use one per hardware thread
+     * @return A hash table with the pipelines and the cities that were affected by the pipeline removal, with the respective impact
+     */
+    unordered_map<Edge *, list<pair<City *, double>>> evaluatePipelineImpact(bool warmStart = true, unsigned threads = 0);
+    /**
+     * @details Find the cities that were affected by the removal of a pipeline, skipping the pipelines that provably have no impact
+     * @details A pre-pass over the optimal flow classifies the pipelines. Pipelines without flow, and pipelines that cross
+     * no minimum cut and whose flow can be rerouted between their endpoints, don't change what any city receives, so they
+     * get the deficits of the network without removals. Only the remaining pipelines are solved.
+     * @details Time Complexity: O(|E| * |V|^2 * |E| / T) in the worst case, usually much less
+     * @details V is the number of vertices/nodes, E is the number of edges/links and T the number of threads.
+     * @param skippedPipes Number of pipelines that were classified as non-critical and skipped
+     * @param solvedPipes Number of pipelines whose removal had to be solved
+     * @param warmStart True to repair the optimal flow incrementally, False to solve from zero flow for every pipeline
+     * @param threads Number of worker threads, 0 to use one per hardware thread
      * @return A hash table with the pipelines and the cities that were affected by the pipeline removal, with the respective impact
      */
-    unordered_map<Edge *, list<pair<City *, double>>> evaluatePipelineImpact();
+    unordered_map<Edge *, list<pair<City *, double>>> evaluatePipelineImpact(int &skippedPipes, int &solvedPipes, bool warmStart = true, unsigned threads = 0);
+    /**
+     * @details Find the cities that are affected by the removal of each reservoir, one at a time, using worker threads
+     * @details Time Complexity: O(|R| * |V|^2 * |E| / T)
+     * @details R is the number of reservoirs, V the number of vertices/nodes, E the number of edges/links and T the number of threads.
+     * @param threads Number of worker threads, 0 to use one per hardware thread
+     * @return A hash table with the reservoirs' symbols and the cities that were affected by their removal, with the respective impact
+     */
+    unordered_map<uint32_t, list<pair<City *, double>>> evaluateAllReservoirsImpact(unsigned threads = 0);
+    /**
+     * @details Find the cities that are affected by the removal of each pumping station, one at a time, using worker threads
+     * @details Time Complexity: O(|P| * |V|^2 * |E| / T)
+     * @details P is the number of pumping stations, V the number of vertices/nodes, E the number of edges/links and T the number of threads.
+     * @param threads Number of worker threads, 0 to use one per hardware thread
+     * @return A hash table with the stations' symbols and the cities that were affected by their removal, with the respective impact
+     */
+    unordered_map<uint32_t, list<pair<City *, double>>> evaluateAllPumpingStationsImpact(unsigned threads = 0);
+    /**
+     * @details N-k contingency analysis: find the sets of k pipelines whose simultaneous failure causes the largest total deficit
+     * @details The sets are enumerated by branch and bound over the pipelines sorted by decreasing flow. Removing pipelines
+     * can't lose more flow than they carry in the solution without failures, so a branch is pruned when the flow of its
+     * pipelines plus the largest flows that can still be added can't exceed the threshold. Once maxResults sets are found
+     * the threshold is raised to the smallest loss among them. Each level of the search warm starts from the flow of its parent.
+     * @details Time Complexity: O(|E|^k * |V|^2 * |E|) in the worst case, usually much less because of the pruning
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param k Number of pipelines that fail together
+     * @param threshold Minimum flow loss, compared to the network without failures, for a set to be reported
+     * @param maxResults Maximum number of sets to report
+     * @param evaluatedSets Number of sets whose flow was solved
+     * @param prunedSets Number of sets skipped by the bound
+     * @return The worst sets of pipelines with the total deficit they cause, sorted by decreasing deficit
+     */
+    list<pair<vector<Edge *>, double>> evaluateContingencies(int k, double threshold, int maxResults, long long &evaluatedSets, long long &prunedSets);
+    /**
+     * @details Recursive step of the N-k contingency analysis, choosing the next pipeline to fail from the given position
+     * @details Time Complexity: O(|E|^r * |V|^2 * |E|)
+     * @details r is the number of pipelines still to choose, V the number of vertices/nodes and E the number of edges/links.
+     * @param search State of the search
+     * @param start First candidate that can be chosen
+     * @param bound Flow of the pipelines already chosen, in the solution without failures
+     */
+    static void searchContingencies(ContingencySearch &search, size_t start, long long bound);
+    /**
+     * @details Number of ways to choose r elements out of n, saturated at the largest long long
+     * @details Time Complexity: O(r)
+     * @param n Number of elements
+     * @param r Number of elements to choose
+     * @return The number of combinations
+     */
+    static long long countCombinations(long long n, int r);
+    /**
+     * @details Evaluates independent removals, each one a set of arcs of a solved network, on worker threads
+     * @details Each worker copies the solved network, and for every removal restores the optimal flow and disables the arcs
+     * @details Time Complexity: O(S * |V|^2 * |E| / T)
+     * @details S is the number of removals, V the number of vertices/nodes, E the number of edges/links and T the number of threads.
+     * @param network The solved network
+     * @param removals The arcs to disable in each removal
+     * @param warmStart True to repair the optimal flow incrementally, False to solve from zero flow
+     * @param threads Number of worker threads, 0 to use one per hardware thread
+     * @return The cities with a water deficit after each removal, sorted by decreasing deficit
+     */
+    vector<list<pair<City *, double>>> evaluateRemovals(const FlowNetwork &network, const vector<vector<int>> &removals, bool warmStart, unsigned threads) const;
+    /**
+     * @details Evaluates a batch of what-if scenarios against one max flow of the unchanged network
+     * @details The network is solved once, if it isn't already. Each scenario is applied as capacity changes to a copy of
+     * that solution and repaired incrementally, on worker threads that each own a copy, and the copy is reset to the
+     * baseline flow before the next scenario. The Graph isn't changed.
+     * @details Time Complexity: O(S * |V|^2 * |E| / T) in the worst case, usually much less with warm starts
+     * @details S is the number of scenarios, V the number of vertices/nodes, E the number of edges/links and T the number of threads.
+     * @param scenarios The scenarios
+     * @param threads Number of worker threads, 0 to use one per hardware thread
+     * @return The deficit of every city in every scenario, with the reason for the scenarios that couldn't be evaluated
+     */
+    ScenarioTable evaluateScenarios(const vector<Scenario> &scenarios, unsigned threads);
 };
 
+template<typename T>
+T* Graph::addNode(T node) {
+    uint32_t symbol = symbols.intern(node.getCode());
+    if (symbol >= nodes.size()) {
+        nodes.resize(symbol + 1, nullptr);
+    }
+    if (nodes[symbol] != nullptr) {
+        return nullptr;
+    }
+    T* added = arena.create<T>(std::move(node));
+    added->setSymbol(symbol);
+    nodes[symbol] = added;
+    networkOutdated = true;
+    return added;
+}
+
 #endif //DA_RAILWAYS_GRAPH_H
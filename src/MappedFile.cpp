@@ -0,0 +1,54 @@
+#include "MappedFile.h"
+
+#include <fstream>
+#include <iterator>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::MappedFile(const string& path) {
+#ifndef _WIN32
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd >= 0) {
+        struct stat info{};
+        if (fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* region = mmap(nullptr, (size_t) info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (region != MAP_FAILED) {
+                data = (const char*) region;
+                size = (size_t) info.st_size;
+                mapped = true;
+            }
+        }
+        close(fd);
+    }
+#endif
+    if (!mapped) {
+        ifstream file(path, ios::binary);
+        if (file.is_open()) {
+            buffer.assign(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+            data = buffer.data();
+            size = buffer.size();
+        }
+    }
+}
+
+MappedFile::~MappedFile() {
+#ifndef _WIN32
+    if (mapped) munmap((void*) data, size);
+#endif
+}
+
+bool MappedFile::isOpen() const {
+    return data != nullptr;
+}
+
+const char* MappedFile::getData() const {
+    return data;
+}
+
+size_t MappedFile::getSize() const {
+    return size;
+}
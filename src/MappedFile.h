@@ -0,0 +1,67 @@
+#ifndef DA2324_PROJ1_MAPPEDFILE_H
+#define DA2324_PROJ1_MAPPEDFILE_H
+
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class MappedFile
+ * @details Read-only view of the bytes of a file, mapped into memory so it isn't copied.
+ * @details Where the file can't be mapped it is read into a buffer instead.
+ */
+class MappedFile {
+private:
+    /**
+     * @details Bytes of the file
+     */
+    const char* data = nullptr;
+    /**
+     * @details Number of bytes of the file
+     */
+    size_t size = 0;
+    /**
+     * @details True if data is a memory mapping that has to be released
+     */
+    bool mapped = false;
+    /**
+     * @details Copy of the file when it can't be mapped
+     */
+    vector<char> buffer;
+public:
+    /**
+     * @details Opens and maps the file
+     * @details Time Complexity: O(1), O(N) if the file has to be read into a buffer
+     * @details N is the size of the file
+     * @param path Path of the file
+     */
+    explicit MappedFile(const string& path);
+    /**
+     * @details Releases the mapping of the file
+     */
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    /**
+     * @details Checks if the file could be opened
+     * @details Time Complexity: O(1)
+     * @return True - If the file was opened.
+     * @return False - If it couldn't be opened.
+     */
+    bool isOpen() const;
+    /**
+     * @details Normal method that returns the bytes of the file
+     * @details Time Complexity: O(1)
+     * @return The first byte of the file
+     */
+    const char* getData() const;
+    /**
+     * @details Normal method that returns the size of the file
+     * @details Time Complexity: O(1)
+     * @return The number of bytes of the file
+     */
+    size_t getSize() const;
+};
+
+#endif //DA2324_PROJ1_MAPPEDFILE_H
@@ -4,6 +4,10 @@ Menu::Menu() : data(Data()) {
     SelectGraphMenu();
 }
 
+const Graph& Menu::getNetwork() const {
+    return data.getWaterNetwork();
+}
+
 void Menu::printTitle() {
     cout << R"(
 _____________________________________________________________________________________________________________________
@@ -26,6 +30,17 @@ void Menu::Print(const string& s, int linelength) {
     if (uneven) cout << " ";
 }
 
+void Menu::printCitiesCutOff(const vector<City*> &cities) {
+    if (cities.empty()) {
+        return;
+    }
+    cout << "Cities that lose all supply:";
+    for (size_t i = 0; i < cities.size(); i++) {
+        cout << (i == 0 ? " " : ", ") << cities[i]->getCode();
+    }
+    cout << "\n\n";
+}
+
 void Menu::clearScreen() {
     for (int i = 0; i < 20; i++) {
         cout << "\n";
@@ -74,26 +89,41 @@ string Menu::getUserTextInput() {
 void Menu::SelectGraphMenu() {
     printTitle();
     cout << "\n";
+    if (!getNetwork().getNodes().empty()) {
+        const Arena& arena = getNetwork().getArena();
+        size_t objects = arena.getNumObjects(), reserved = arena.getReservedBytes();
+        data = Data();
+        cout << "Released " << objects << " nodes and edges (" << reserved / 1024 << " KB) of the previous dataset, "
+             << getNetwork().getArena().getReservedBytes() / 1024 << " KB in use now\n";
+    }
     cout << "\tSelect Graph Menu\n";
     cout << "(1) Large Dataset\n";
     cout << "(2) Small Dataset\n";
+    cout << "(3) Custom Dataset (manifest file)\n";
     cout << "(0) Exit\n";
     cout << " > ";
 
-    if (!data.getWaterNetwork().getNodes().empty()) {
-        data = Data();
-    }
-
-    int input = getUserInput({0, 1, 2});
+    int input = getUserInput({0, 1, 2, 3});
     switch (input) {
         case 1:
             clearScreen();
-            data.readData("");
+            data.loadData("");
             MainMenu();
         case 2:
             clearScreen();
-            data.readData("_Madeira");
+            data.loadData("_Madeira");
+            MainMenu();
+        case 3: {
+            cout << "\nWrite the path of the manifest file: ";
+            DatasetFiles files;
+            if (!Data::readManifest(getUserTextInput(), files)) {
+                cout << "The manifest couldn't be read or doesn't list the reservoirs, stations, cities and pipes files. Try Again.\n\n";
+                SelectGraphMenu();
+            }
+            clearScreen();
+            data.loadData(files);
             MainMenu();
+        }
         case 0:
             exit(0);
         default:
@@ -105,14 +135,24 @@ void Menu::MainMenu() {
     printTitle();
     cout << "\n";
     cout << "\tMain Menu\n";
+    double loadSeconds = data.getLoadSeconds();
+    stringstream x, y;
+    x << fixed << setprecision(2) << loadSeconds * 1000;
+    y << fixed << setprecision(0) << (loadSeconds > 0 ? data.getLoadedRows() / loadSeconds : 0);
+    cout << "Loaded " << data.getLoadedRows() << (data.isLoadedFromSnapshot() ? " records from snapshot (" : " rows (")<< data.getLoadedBytes() / 1024 << " KB) in " << x.str()
+         << " ms, " << y.str() << (data.isLoadedFromSnapshot() ? " records/sec\n" : " rows/sec\n");
+    const Arena& arena = getNetwork().getArena();
+    cout << "Nodes and edges: " << arena.getNumObjects() << " objects, " << arena.getUsedBytes() / 1024 << " KB used of "
+         << arena.getReservedBytes() / 1024 << " KB reserved\n";
     cout << "(1) Node Information\n";
     cout << "(2) Water Network Menu\n";
     cout << "(3) Resiliency Menu\n";
-    cout << "(4) Back to Select Graph Menu\n";
+    cout << "(4) Max Flow Algorithm\n";
+    cout << "(5) Back to Select Graph Menu\n";
     cout << "(0) Exit\n";
     cout << " > ";
 
-    int input = getUserInput({0, 1, 2, 3, 4});
+    int input = getUserInput({0, 1, 2, 3, 4, 5});
     switch (input) {
         case 1:
             clearScreen();
@@ -124,6 +164,9 @@ void Menu::MainMenu() {
             clearScreen();
             ResiliencyMenu();
         case 4:
+            clearScreen();
+            FlowAlgorithmMenu();
+        case 5:
             clearScreen();
             SelectGraphMenu();
         case 0:
@@ -147,7 +190,7 @@ void Menu::NodeInfo() {
     int input = getUserInput({0, 1, 2, 3, 4});
     switch (input) {
         case 1:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
                 int count = 0;
                 // Print the cities
                 cout << "\n\n";
@@ -161,8 +204,8 @@ void Menu::NodeInfo() {
                 cout << "|\n";
                 for (int i = 0; i < 65; ++i) cout << "-";
                 cout << "\n";
-                for (auto& it : data.getWaterNetwork().getNodes()) {
-                    if (City* city = dynamic_cast<City*>(it.second)) {
+                for (auto node : getNetwork().getNodes()) {
+                    if (City* city = dynamic_cast<City*>(node)) {
                         Print(to_string(city->getId()), 6);
                         Print(city->getCode(), 8);
                         Print(city->getCityName(), 20);
@@ -188,8 +231,8 @@ void Menu::NodeInfo() {
                 cout << "|\n";
                 for (int i = 0; i < 87; ++i) cout << "-";
                 cout << "\n";
-                for (auto& it : data.getWaterNetwork().getNodes()) {
-                    if (auto* reservoir = dynamic_cast<Reservoir*>(it.second)) {
+                for (auto node : getNetwork().getNodes()) {
+                    if (auto* reservoir = dynamic_cast<Reservoir*>(node)) {
                         Print(to_string(reservoir->getId()), 6);
                         Print(reservoir->getCode(), 8);
                         Print(reservoir->getReservoirName(), 20);
@@ -210,8 +253,8 @@ void Menu::NodeInfo() {
                 cout << "|\n";
                 for (int i = 0; i < 17; ++i) cout << "-";
                 cout << "\n";
-                for (auto& it : data.getWaterNetwork().getNodes()) {
-                    if (auto* pumpingStation = dynamic_cast<PumpingStation*>(it.second)) {
+                for (auto node : getNetwork().getNodes()) {
+                    if (auto* pumpingStation = dynamic_cast<PumpingStation*>(node)) {
                         Print(to_string(pumpingStation->getId()), 6);
                         Print(pumpingStation->getCode(), 8);
                         cout << "|\n";
@@ -238,14 +281,15 @@ void Menu::NodeInfo() {
                 }
             }
         case 2:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
                 cout << "\n\nWrite the code of the node you want to search for: ";
                 string textInput = getUserTextInput();
-                if (!data.checkIfItExists(textInput)) {
+                const Node* node = getNetwork().getNode(textInput);
+                if (node == nullptr) {
                     cout << "That Node doesn't exist. Try Again.\n\n";
                     NodeInfo();
                 }
-                if (auto* city = dynamic_cast<City*>(data.getWaterNetwork().getNodes().find(textInput)->second)) {
+                if (auto* city = dynamic_cast<const City*>(node)) {
                     cout << "\n\n";
                     for (int i = 0; i < 65; ++i) cout << "-";
                     cout << "\n";
@@ -267,7 +311,7 @@ void Menu::NodeInfo() {
                     cout << "|\n";
                     for (int i = 0; i < 65; ++i) cout << "-";
                     cout << "\n";
-                } else if (auto* reservoir = dynamic_cast<Reservoir*>(data.getWaterNetwork().getNodes().find(textInput)->second)) {
+                } else if (auto* reservoir = dynamic_cast<const Reservoir*>(node)) {
                     cout << "\n\n";
                     for (int i = 0; i < 87; ++i) cout << "-";
                     cout << "\n";
@@ -287,7 +331,7 @@ void Menu::NodeInfo() {
                     cout << "|\n";
                     for (int i = 0; i < 87; ++i) cout << "-";
                     cout << "\n";
-                } else if (auto* pumpingStation = dynamic_cast<PumpingStation*>(data.getWaterNetwork().getNodes().find(textInput)->second)) {
+                } else if (auto* pumpingStation = dynamic_cast<const PumpingStation*>(node)) {
                     cout << "\n\n";
                     for (int i = 0; i < 17; ++i) cout << "-";
                     cout << "\n";
@@ -315,14 +359,13 @@ void Menu::NodeInfo() {
                 for (int i = 0; i < 38; ++i) cout << "-";
                 cout << "\n";
 
-                auto edges = data.getWaterNetwork().getEdges(textInput);
-                edges.merge(data.getWaterNetwork().getIncomingEdges(textInput));
-
-                for (const auto& edge : edges) {
-                    Print(edge->getOrigin(), 10);
-                    Print(edge->getDest(), 13);
-                    Print(to_string(edge->getCapacity()), 10);
-                    cout << "|\n";
+                for (const auto* edges : {&node->getEdges(), &node->getIncomingEdges()}) {
+                    for (const Edge* edge : *edges) {
+                        Print(getNetwork().getCode(edge->getOrigin()), 10);
+                        Print(getNetwork().getCode(edge->getDest()), 13);
+                        Print(to_string(edge->getCapacity()), 10);
+                        cout << "|\n";
+                    }
                 }
                 for (int i = 0; i < 38; ++i) cout << "-";
                 cout << "\n\n";
@@ -363,16 +406,15 @@ void Menu::MaxFlowMenu() {
     cout << "(0) Exit\n";
     cout << " > ";
 
-    data.MaxFlow();
-
     int input = getUserInput({0, 1, 2, 3});
     switch (input) {
         case 1:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
+                data.MaxFlow();
                 cout << "\n\nPlease enter the target City's code: ";
                 string targetCity = getUserTextInput();
-                if (data.checkIfItExists(targetCity)) {
-                    if (auto* city = dynamic_cast<City*>(data.getWaterNetwork().getNodes().find(targetCity)->second)) {
+                if (Node* node = getNetwork().getNode(targetCity)) {
+                    if (auto* city = dynamic_cast<City*>(node)) {
                         cout << "\n";
                         for (int i = 0; i < 76; ++i) cout << "-";
                         cout << "\n";
@@ -393,7 +435,7 @@ void Menu::MaxFlowMenu() {
                         Print(x.str(), 10);
                         Print(to_string(city->getPopulation()), 15);
                         double maxFlow = 0;
-                        for (const auto& edge : data.getWaterNetwork().getIncomingEdges(targetCity)) {
+                        for (const auto& edge : city->getIncomingEdges()) {
                             maxFlow += edge->getFlow();
                         }
                         stringstream y;
@@ -401,7 +443,12 @@ void Menu::MaxFlowMenu() {
                         Print(y.str(), 10);
                         cout << "|\n";
                         for (int i = 0; i < 76; ++i) cout << "-";
-                        cout << "\n\n";
+                        int upstreamNodes = 0;
+                        long long reach = getNetwork().maxFlowToCity(targetCity, upstreamNodes);
+                        cout << "\n\nMax Flow is the water " << city->getCode()
+                             << " gets in the max flow of the whole network, shared with every other city.\n"
+                             << "If it were the only city supplied, up to " << reach << " could reach it (solved on the "
+                             << upstreamNodes << " nodes that can reach " << city->getCode() << ").\n\n";
                     } else {
                         cout << "\n\nThat code does not correspond to a City. Try Again.\n\n";
                         MaxFlowMenu();
@@ -425,7 +472,8 @@ void Menu::MaxFlowMenu() {
                 }
             }
         case 2:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
+                data.MaxFlow();
                 cout << "\n";
                 for (int i = 0; i < 76; ++i) cout << "-";
                 cout << "\n";
@@ -438,8 +486,8 @@ void Menu::MaxFlowMenu() {
                 cout << "|\n";
                 for (int i = 0; i < 76; ++i) cout << "-";
                 cout << "\n";
-                for (auto& it : data.getWaterNetwork().getNodes()) {
-                    if (auto* city = dynamic_cast<City*>(it.second)) {
+                for (auto node : getNetwork().getNodes()) {
+                    if (auto* city = dynamic_cast<City*>(node)) {
                         Print(to_string(city->getId()), 6);
                         Print(city->getCode(), 8);
                         Print(city->getCityName(), 20);
@@ -448,7 +496,7 @@ void Menu::MaxFlowMenu() {
                         Print(x.str(), 10);
                         Print(to_string(city->getPopulation()), 15);
                         double maxFlow = 0;
-                        for (const auto& edge : data.getWaterNetwork().getIncomingEdges(city->getCode())) {
+                        for (const auto& edge : city->getIncomingEdges()) {
                             maxFlow += edge->getFlow();
                         }
                         stringstream y;
@@ -488,16 +536,18 @@ void Menu::WaterNetworkMenu() {
     cout << "\tWater Network Menu\n";
     cout << "(1) Water flow in deficit\n";
     cout << "(2) Flow Redistribution\n";
-    cout << "(3) Back to Main Menu\n";
+    cout << "(3) Bottleneck pipes (minimum cut)\n";
+    cout << "(4) Demand simulation from hourly profiles\n";
+    cout << "(5) Back to Main Menu\n";
     cout << "(0) Exit\n";
     cout << " > ";
 
-    data.getWaterNetwork().edmondsKarp();
+    data.getWaterNetwork().maxFlow();
 
-    int input = getUserInput({0, 1, 2, 3});
+    int input = getUserInput({0, 1, 2, 3, 4, 5});
     switch (input) {
         case 1:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
                 int totalSupply = 0;
                 float totalDemand = 0;
                 float totalDeficit = 0;
@@ -513,7 +563,7 @@ void Menu::WaterNetworkMenu() {
                 cout << "|\n";
                 for (int i = 0; i < 76; ++i) cout << "-";
                 cout << "\n";
-                for (auto pair : data.getWaterNetwork().WaterDeficit(totalSupply, totalDemand)) {
+                for (auto pair : getNetwork().WaterDeficit(totalSupply, totalDemand)) {
                     Print(to_string(pair.first->getId()), 6);
                     Print(pair.first->getCode(), 8);
                     Print(pair.first->getCityName(), 20);
@@ -569,7 +619,7 @@ void Menu::WaterNetworkMenu() {
             }
             break;
         case 2:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
                 double maxDifference = 0;
                 double averageDifference = 0;
                 double variance = 0;
@@ -596,13 +646,13 @@ void Menu::WaterNetworkMenu() {
                 for (int i = 0; i < 102; ++i) cout << "-";
                 cout << "\n";
 
-                auto initialMetrics = data.getWaterNetwork().ComputeMetrics(maxDifference, averageDifference, variance);
+                auto initialMetrics = getNetwork().ComputeMetrics(maxDifference, averageDifference, variance);
                 data.getWaterNetwork().balanceLoad(initialMetrics);
-                auto finalMetrics = data.getWaterNetwork().ComputeMetrics(maxDifference2, averageDifference2, variance2);
+                auto finalMetrics = getNetwork().ComputeMetrics(maxDifference2, averageDifference2, variance2);
 
                 for (auto pair : initialMetrics) {
-                    Print(pair.first->getOrigin(), 10);
-                    Print(pair.first->getDest(), 15);
+                    Print(getNetwork().getCode(pair.first->getOrigin()), 10);
+                    Print(getNetwork().getCode(pair.first->getDest()), 15);
                     Print(to_string(pair.first->getCapacity()), 12);
                     Print(to_string(pair.first->getCapacity() - (int) pair.second), 13);
                     Print(to_string((int) pair.second), 16);
@@ -665,6 +715,128 @@ void Menu::WaterNetworkMenu() {
                 }
             }
         case 3:
+            if (!getNetwork().getNodes().empty()) {
+                list<Edge*> minCut;
+                long long cutCapacity = 0;
+                int cutReservoirs = 0;
+                int cutCities = 0;
+                auto sensitivity = data.getWaterNetwork().ComputeSensitivity(minCut, cutCapacity, cutReservoirs, cutCities);
+                unordered_map<Edge*, int> gain(sensitivity.begin(), sensitivity.end());
+                int bottlenecks = 0;
+                cout << "\n";
+                for (int i = 0; i < 65; ++i) cout << "-";
+                cout << "\n";
+                Print("Origin", 12);
+                Print("Destination", 15);
+                Print("Capacity", 12);
+                Print("Flow", 10);
+                Print("+1 Gain", 10);
+                cout << "|\n";
+                for (int i = 0; i < 65; ++i) cout << "-";
+                cout << "\n";
+                for (Edge* edge : minCut) {
+                    Print(getNetwork().getCode(edge->getOrigin()), 12);
+                    Print(getNetwork().getCode(edge->getDest()), 15);
+                    Print(to_string(edge->getCapacity()), 12);
+                    Print(to_string((int) edge->getFlow()), 10);
+                    Print(to_string(gain[edge]), 10);
+                    cout << "|\n";
+                    bottlenecks += gain[edge];
+                }
+                for (int i = 0; i < 65; ++i) cout << "-";
+                cout << "\n\n";
+                cout << "The minimum cut has a capacity of " << cutCapacity << ", the max flow: " << minCut.size()
+                     << " pipes, " << cutReservoirs << " reservoirs at their maximum delivery and " << cutCities
+                     << " cities that get all of their demand.\n";
+                cout << "One more unit of capacity on any of the " << bottlenecks
+                     << " pipes with a gain of 1 raises the max flow by one unit; on any other pipe it changes nothing.\n";
+
+                cout << "\n\n(1) Go back to the Main Menu\n";
+                cout << "(0) Exit\n";
+                cout << " > ";
+                input = getUserInput({0, 1});
+                switch (input) {
+                    case 1:
+                        clearScreen();
+                        MainMenu();
+                    case 0:
+                        exit(0);
+                    default:
+                        break;
+                }
+            }
+        case 4:
+            if (!getNetwork().getNodes().empty()) {
+                cout << "\n\nPlease enter the path of the demand profiles file, e.g. ../data/DemandProfiles_Madeira.csv: ";
+                string path = getUserTextInput();
+                DemandSimulation simulation(data.getWaterNetwork());
+                int unknownCities = 0;
+                if (!simulation.loadProfiles(path, unknownCities)) {
+                    cout << "\n\nThe demand profiles couldn't be read. Try Again.\n\n";
+                    WaterNetworkMenu();
+                }
+                auto start = chrono::steady_clock::now();
+                auto steps = simulation.run();
+                double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+
+                int stepsInDeficit = 0;
+                double totalDeficit = 0;
+                for (const auto& step : steps) {
+                    stepsInDeficit += step.deficit > 0;
+                    totalDeficit += step.deficit;
+                }
+                stringstream summary;
+                summary << "\nSimulated " << steps.size() << " timesteps in " << fixed << setprecision(1) << elapsed << " ms";
+                if (unknownCities > 0) {
+                    summary << ", ignoring " << unknownCities << " rows that aren't cities of this network";
+                }
+                summary << ".\n" << stepsInDeficit << " timesteps have a deficit, " << setprecision(2) << totalDeficit
+                        << " in total. The worst ones:\n\n";
+                cout << summary.str();
+
+                stable_sort(steps.begin(), steps.end(), [](const SimulationStep& a, const SimulationStep& b) {
+                    return a.deficit > b.deficit;
+                });
+                steps.resize(min(steps.size(), (size_t) 10));
+                for (int i = 0; i < 81; ++i) cout << "-";
+                cout << "\n";
+                Print("Timestep", 16);
+                Print("Demand", 14);
+                Print("Delivered", 14);
+                Print("Deficit", 12);
+                Print("Cities in deficit", 19);
+                cout << "|\n";
+                for (int i = 0; i < 81; ++i) cout << "-";
+                cout << "\n";
+                for (const auto& step : steps) {
+                    Print(step.label, 16);
+                    stringstream x;
+                    x << fixed << setprecision(2) << step.demand;
+                    Print(x.str(), 14);
+                    Print(to_string(step.delivered), 14);
+                    stringstream y;
+                    y << fixed << setprecision(2) << step.deficit;
+                    Print(y.str(), 12);
+                    Print(to_string(step.citiesInDeficit), 19);
+                    cout << "|\n";
+                }
+                for (int i = 0; i < 81; ++i) cout << "-";
+
+                cout << "\n\n(1) Go back to the Main Menu\n";
+                cout << "(0) Exit\n";
+                cout << " > ";
+                input = getUserInput({0, 1});
+                switch (input) {
+                    case 1:
+                        clearScreen();
+                        MainMenu();
+                    case 0:
+                        exit(0);
+                    default:
+                        break;
+                }
+            }
+        case 5:
             clearScreen();
             MainMenu();
         case 0:
@@ -681,19 +853,22 @@ void Menu::ResiliencyMenu() {
     cout << "(1) Resiliency check: Removing a Reservoir\n";
     cout << "(2) Resiliency check: Removing a Pumping Station\n";
     cout << "(3) Resiliency check: Removing all Edges, one at a time\n";
-    cout << "(4) Go back to Main Menu\n";
+    cout << "(4) Resiliency check: Worst sets of Edges failing together (N-k)\n";
+    cout << "(5) Go back to Main Menu\n";
     cout << "(0) Exit\n";
     cout << " > ";
 
-    int input = getUserInput({0, 1, 2, 3, 4});
+    int input = getUserInput({0, 1, 2, 3, 4, 5});
     switch (input) {
         case 1:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
                 cout << "\n\nPlease enter the code of the Reservoir you want to remove: ";
                 string reservoirCode = getUserTextInput();
-                if (data.checkIfItExists(reservoirCode)) {
-                    if (auto reservoir = dynamic_cast<Reservoir*>(data.getWaterNetwork().getNodes().find(reservoirCode)->second)) {
+                if (Node* node = getNetwork().getNode(reservoirCode)) {
+                    if (auto* reservoir = dynamic_cast<Reservoir*>(node)) {
                         cout << "\n\nThe Reservoir named" << reservoir->getReservoirName() << " has been temporarily removed.\n\n";
+                        printCitiesCutOff(data.getWaterNetwork().getCitiesCutOffBy(reservoirCode));
+                        cout << "Cities in deficit without it, including the ones that lose all supply:\n";
                         for (int i = 0; i < 76; ++i) cout << "-";
                         cout << "\n";
                         Print("Id", 6);
@@ -742,16 +917,17 @@ void Menu::ResiliencyMenu() {
                 }
             }
         case 2:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
                 cout << "\n\nPlease enter the code of the Pumping Station you want to remove: ";
                 string psCode = getUserTextInput();
-                if (data.checkIfItExists(psCode)) {
-                    if (auto pumpingStation = dynamic_cast<PumpingStation*>(data.getWaterNetwork().getNodes().find(psCode)->second)) {
+                if (Node* node = getNetwork().getNode(psCode)) {
+                    if (auto* pumpingStation = dynamic_cast<PumpingStation*>(node)) {
                         cout << "\n\nThe Pumping Station number " << pumpingStation->getId() << " has been temporarily removed.\n\n";
+                        printCitiesCutOff(data.getWaterNetwork().getCitiesCutOffBy(psCode));
                         auto list = data.getWaterNetwork().evaluatePumpingStationImpact(psCode);
                         int unused = 0;
                         float unused2 = 0;
-                        auto normalList = data.getWaterNetwork().WaterDeficit(unused, unused2);
+                        auto normalList = getNetwork().WaterDeficit(unused, unused2);
                         bool equal = true;
                         if (list.size() != normalList.size()) {
                             equal = false;
@@ -781,6 +957,7 @@ void Menu::ResiliencyMenu() {
                                     break;
                             }
                         }
+                        cout << "Cities in deficit without it, including the ones that lose all supply:\n";
                         for (int i = 0; i < 76; ++i) cout << "-";
                         cout << "\n";
                         Print("Id", 6);
@@ -829,7 +1006,7 @@ void Menu::ResiliencyMenu() {
                 }
             }
         case 3:
-            if (!data.getWaterNetwork().getNodes().empty()) {
+            if (!getNetwork().getNodes().empty()) {
                 cout << "\n\n";
                 for (int i = 0; i < 106; ++i) cout << "-";
                 cout << "\n";
@@ -850,9 +1027,11 @@ void Menu::ResiliencyMenu() {
                 cout << "|\n";
                 for (int i = 0; i < 106; ++i) cout << "-";
                 cout << "\n";
-                for (const auto& pair : data.getWaterNetwork().evaluatePipelineImpact()) {
-                    Print(pair.first->getOrigin(), 8);
-                    Print(pair.first->getDest(), 13);
+                int skippedPipes = 0;
+                int solvedPipes = 0;
+                for (const auto& pair : data.getWaterNetwork().evaluatePipelineImpact(skippedPipes, solvedPipes)) {
+                    Print(getNetwork().getCode(pair.first->getOrigin()), 8);
+                    Print(getNetwork().getCode(pair.first->getDest()), 13);
                     Print(to_string(pair.first->getCapacity()), 10);
                     bool first = true;
                     for (auto pair2 : pair.second) {
@@ -877,6 +1056,59 @@ void Menu::ResiliencyMenu() {
                     for (int i = 0; i < 106; ++i) cout << "-";
                         cout << "\n";
                 }
+                cout << "\n" << skippedPipes << " pipelines carry no flow or can be rerouted and were skipped, "
+                     << solvedPipes << " pipelines were solved.\n";
+                cout << "\n\n(1) Go back to the Main Menu\n";
+                cout << "(0) Exit\n";
+                cout << " > ";
+                input = getUserInput({0, 1});
+                switch (input) {
+                    case 1:
+                        clearScreen();
+                        MainMenu();
+                    case 0:
+                        exit(0);
+                    default:
+                        break;
+                }
+            }
+        case 4:
+            if (!getNetwork().getNodes().empty()) {
+                cout << "\n\nHow many Edges fail at the same time? (1, 2 or 3): ";
+                int k = getUserInput({1, 2, 3});
+                cout << "Minimum flow loss for a set to be reported: ";
+                string threshold = getUserTextInput();
+                while (!all_of(threshold.begin(), threshold.end(), ::isdigit)) {
+                    cerr << "Not a valid input, please input a non-negative integer: ";
+                    threshold = getUserTextInput();
+                }
+                long long evaluatedSets = 0;
+                long long prunedSets = 0;
+                auto worst = data.getWaterNetwork().evaluateContingencies(k, stod(threshold), 10, evaluatedSets, prunedSets);
+                cout << "\n";
+                for (int i = 0; i < 61; ++i) cout << "-";
+                cout << "\n";
+                Print("Rank", 6);
+                Print("Failing Edges", 38);
+                Print("Total Deficit", 14);
+                cout << "|\n";
+                for (int i = 0; i < 61; ++i) cout << "-";
+                cout << "\n";
+                int rank = 1;
+                for (const auto& pair : worst) {
+                    string edges;
+                    for (auto edge : pair.first) {
+                        edges += (edges.empty() ? "" : " ") + getNetwork().getCode(edge->getOrigin()) + "->" + getNetwork().getCode(edge->getDest());
+                    }
+                    Print(to_string(rank++), 6);
+                    Print(edges, 38);
+                    stringstream x;
+                    x << fixed << setprecision(2) << pair.second;
+                    Print(x.str(), 14);
+                    cout << "|\n";
+                }
+                for (int i = 0; i < 61; ++i) cout << "-";
+                cout << "\n\n" << evaluatedSets << " sets were solved, " << prunedSets << " sets were pruned by the bound.\n";
                 cout << "\n\n(1) Go back to the Main Menu\n";
                 cout << "(0) Exit\n";
                 cout << " > ";
@@ -891,6 +1123,53 @@ void Menu::ResiliencyMenu() {
                         break;
                 }
             }
+        case 5:
+            clearScreen();
+            MainMenu();
+        case 0:
+            exit(0);
+        default:
+            break;
+    }
+}
+
+void Menu::FlowAlgorithmMenu() {
+    printTitle();
+    cout << "\n";
+    cout << "\tMax Flow Algorithm Menu\n";
+    cout << "Currently selected: ";
+    switch (data.getFlowAlgorithm()) {
+        case FlowAlgorithm::Dinic:
+            cout << "Dinic\n";
+            break;
+        case FlowAlgorithm::PushRelabel:
+            cout << "Push-Relabel\n";
+            break;
+        default:
+            cout << "Edmonds-Karp\n";
+            break;
+    }
+    cout << "(1) Edmonds-Karp\n";
+    cout << "(2) Dinic\n";
+    cout << "(3) Push-Relabel\n";
+    cout << "(4) Back to Main Menu\n";
+    cout << "(0) Exit\n";
+    cout << " > ";
+
+    int input = getUserInput({0, 1, 2, 3, 4});
+    switch (input) {
+        case 1:
+            data.setFlowAlgorithm(FlowAlgorithm::EdmondsKarp);
+            clearScreen();
+            MainMenu();
+        case 2:
+            data.setFlowAlgorithm(FlowAlgorithm::Dinic);
+            clearScreen();
+            MainMenu();
+        case 3:
+            data.setFlowAlgorithm(FlowAlgorithm::PushRelabel);
+            clearScreen();
+            MainMenu();
         case 4:
             clearScreen();
             MainMenu();
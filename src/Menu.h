@@ -3,6 +3,7 @@
 
 #include <iostream>
 #include "Data.h"
+#include "DemandSimulation.h"
 
 using namespace std;
 
@@ -13,6 +14,12 @@ using namespace std;
  */
 class Menu {
     Data data;
+    /**
+     * @details Normal method that returns a read-only view of the loaded network, used wherever the menus only read it
+     * @details Time Complexity: O(1)
+     * @return The WaterNetwork of the data
+     */
+    const Graph& getNetwork() const;
 public:
     /**
      * @details Constructor of the Menu class.
@@ -49,6 +56,14 @@ public:
      * @param linelength Size of the line
      */
     static void Print(const string &s, int linelength);
+    /**
+     * @details Void method that prints the cities that lose all of their supply, if there are any, before the table of
+     * every city in deficit
+     * @details Time Complexity: O(K)
+     * @details K is the number of cities.
+     * @param cities The cities
+     */
+    static void printCitiesCutOff(const vector<City*> &cities);
     /**
      * @details Normal method that prints the Select Graph menu options to the user.
      * @details Time Complexity: O(1)
@@ -79,6 +94,11 @@ public:
      * @details Time Complexity: O(1)
      */
     void ResiliencyMenu();
+    /**
+     * @details Normal method that prints the Max Flow Algorithm menu options to the user.
+     * @details Time Complexity: O(1)
+     */
+    void FlowAlgorithmMenu();
 };
 
 #endif //DA_RAILWAYS_MENU_H
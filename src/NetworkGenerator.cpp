@@ -0,0 +1,106 @@
+#include "NetworkGenerator.h"
+
+/**
+ * @details Node of the network being generated
+ */
+struct GeneratedNode {
+    string code;
+    int cell;
+};
+
+long long NetworkGenerator::generate(const string &directory, const string &extension, int nodes, unsigned seed) {
+    mt19937 random(seed);
+    nodes = max(nodes, 20);
+    int numReservoirs = max(1, nodes / 20);
+    int numCities = max(1, nodes / 5);
+    int numStations = nodes - numReservoirs - numCities;
+    // About 8 stations per cell
+    int side = max(1, (int) sqrt(numStations / 8.0));
+    uniform_int_distribution<int> anyCell(0, side * side - 1);
+
+    vector<vector<int>> stationsOfCell(side * side);
+    vector<GeneratedNode> stations(numStations);
+    for (int i = 0; i < numStations; i++) {
+        stations[i] = {"PS_" + to_string(i + 1), anyCell(random)};
+        stationsOfCell[stations[i].cell].push_back(i);
+    }
+    // A random station in the cell or in one of its 8 neighbours, -1 if they have none
+    auto nearbyStation = [&](int cell) {
+        int x = cell % side, y = cell / side;
+        for (int attempt = 0; attempt < 16; attempt++) {
+            int nx = x + (int) (random() % 3) - 1, ny = y + (int) (random() % 3) - 1;
+            if (nx < 0 || ny < 0 || nx >= side || ny >= side) continue;
+            const vector<int>& candidates = stationsOfCell[ny * side + nx];
+            if (!candidates.empty()) {
+                return candidates[random() % candidates.size()];
+            }
+        }
+        return stationsOfCell[cell].empty() ? -1 : stationsOfCell[cell][random() % stationsOfCell[cell].size()];
+    };
+
+    ofstream reservoirsFile(directory + "Reservoirs" + extension + ".csv");
+    ofstream stationsFile(directory + "Stations" + extension + ".csv");
+    ofstream citiesFile(directory + "Cities" + extension + ".csv");
+    ofstream pipesFile(directory + "Pipes" + extension + ".csv");
+    if (!reservoirsFile.is_open() || !stationsFile.is_open() || !citiesFile.is_open() || !pipesFile.is_open()) {
+        return -1;
+    }
+    const char* bom = "\xEF\xBB\xBF";
+    reservoirsFile << bom << "Reservoir,Municipality,Id,Code,Maximum Delivery (m3/sec)\n";
+    stationsFile << bom << "Id,Code\n";
+    citiesFile << bom << "City,Id,Code,Demand,Population\n";
+    pipesFile << bom << "Service_Point_A,Service_Point_B,Capacity,Direction\n";
+    long long pipes = 0;
+    auto addPipe = [&](const string& origin, const string& dest, int capacity, bool unidirectional) {
+        pipesFile << origin << "," << dest << "," << capacity << "," << (unidirectional ? 1 : 0) << "\n";
+        pipes++;
+    };
+
+    uniform_int_distribution<int> delivery(500, 5000);
+    long long totalSupply = 0;
+    for (int i = 0; i < numReservoirs; i++) {
+        int maximumDelivery = delivery(random);
+        int cell = anyCell(random);
+        totalSupply += maximumDelivery;
+        string code = "R_" + to_string(i + 1);
+        reservoirsFile << "Reservoir " << i + 1 << ",Municipality " << cell + 1 << "," << i + 1 << "," << code << "," << maximumDelivery << "\n";
+        for (int k = 0; k < 2; k++) {
+            int station = nearbyStation(cell);
+            if (station >= 0) {
+                addPipe(code, stations[station].code, maximumDelivery / 2 + 100, true);
+            }
+        }
+    }
+
+    uniform_int_distribution<int> stationCapacity(200, 3000);
+    for (int i = 0; i < numStations; i++) {
+        stationsFile << i + 1 << "," << stations[i].code << "\n";
+        for (int k = 0; k < 2; k++) {
+            int other = nearbyStation(stations[i].cell);
+            if (other >= 0 && other != i) {
+                addPipe(stations[i].code, stations[other].code, stationCapacity(random), random() % 10 >= 3);
+            }
+        }
+    }
+
+    // Demands add up to about 70% of the supply
+    double meanDemand = 0.7 * (double) totalSupply / numCities;
+    uniform_real_distribution<double> demandFactor(0.2, 1.8);
+    uniform_int_distribution<int> feeders(1, 3);
+    for (int i = 0; i < numCities; i++) {
+        double demand = round(meanDemand * demandFactor(random));
+        int cell = anyCell(random);
+        string code = "C_" + to_string(i + 1);
+        citiesFile << "City " << i + 1 << "," << i + 1 << "," << code << "," << fixed;
+        citiesFile.precision(2);
+        citiesFile << demand << "," << (long long) (demand * 150) << "\n";
+        int count = feeders(random);
+        for (int k = 0; k < count; k++) {
+            int station = nearbyStation(cell);
+            if (station >= 0) {
+                addPipe(stations[station].code, code, (int) (demand / count * 1.5) + 10, true);
+            }
+        }
+    }
+    return pipes;
+}
@@ -0,0 +1,35 @@
+#ifndef DA2324_PROJ1_NETWORKGENERATOR_H
+#define DA2324_PROJ1_NETWORKGENERATOR_H
+
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class NetworkGenerator
+ * @details Generates synthetic water supply networks in the schema of the CSV files of the datasets.
+ * @details Nodes are scattered over a square divided into a grid of cells. About 5% are reservoirs, 75% pumping
+ * stations and 20% cities, like in the mainland dataset. Pipes only join nodes in the same or in neighbouring cells,
+ * so the network is sparse and local: each reservoir feeds nearby stations, stations form a mesh with some
+ * bidirectional pipes, and each city is fed by nearby stations. The total demand is about 70% of the total supply.
+ */
+class NetworkGenerator {
+public:
+    /**
+     * @details Writes Reservoirs, Stations, Cities and Pipes files of a synthetic network
+     * @details Time Complexity: O(N)
+     * @details N is the number of nodes.
+     * @param directory Directory of the files, empty for the current one, ending in a separator otherwise
+     * @param extension Extension added to the names of the files, e.g. "_Synthetic1000"
+     * @param nodes Number of nodes of the network, at least 20
+     * @param seed Seed of the random generator, the same seed always gives the same network
+     * @return The number of pipes written, -1 if a file couldn't be written
+     */
+    static long long generate(const string &directory, const string &extension, int nodes, unsigned seed);
+};
+
+#endif //DA2324_PROJ1_NETWORKGENERATOR_H
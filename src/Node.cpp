@@ -4,10 +4,13 @@
 Node::Node(int id, string code) : Id(id), Code(std::move(code)) {}
 
 int Node::getId() const {return Id;}
-string Node::getCode() const {return Code;}
+const string& Node::getCode() const {return Code;}
+uint32_t Node::getSymbol() const {return Symbol;}
+void Node::setSymbol(uint32_t symbol) {Symbol = symbol;}
 
 bool Node::getVisited() const {return visited;}
-list<Edge*> Node::getEdges() const {return edges;}
+const list<Edge*>& Node::getEdges() const {return edges;}
+const list<Edge*>& Node::getIncomingEdges() const {return incomingEdges;}
 Edge* Node::getPath() const {return path;}
 int Node::getNumEdges() const {return (int) edges.size();}
 
@@ -15,17 +18,16 @@ void Node::setVisited(bool Visited) {visited = Visited;}
 void Node::setPath(Edge *Path) {path = Path;}
 
 void Node::addEdge(Edge *edge) {edges.push_back(edge);}
-void Node::removeEdge(Edge *edge) {
-    edges.remove(edge);
-    delete edge;
-}
+void Node::removeEdge(Edge *edge) {edges.remove(edge);}
+void Node::addIncomingEdge(Edge *edge) {incomingEdges.push_back(edge);}
+void Node::removeIncomingEdge(Edge *edge) {incomingEdges.remove(edge);}
 
 /*------ City class ------*/
 City::City(int id, string code, string city, float demand, int population) : Node(id, std::move(code)), CityName(std::move(city)), Demand(demand), Population(population) {}
 
 int City::getId() const {return Node::getId();}
-string City::getCode() const {return Node::getCode();}
-string City::getCityName() const {return CityName;}
+const string& City::getCode() const {return Node::getCode();}
+const string& City::getCityName() const {return CityName;}
 float City::getDemand() const {return Demand;}
 int City::getPopulation() const {return Population;}
 
@@ -33,13 +35,13 @@ int City::getPopulation() const {return Population;}
 Reservoir::Reservoir(int id, string code, string reservoir, string municipality, int maximumDelivery) : Node(id, std::move(code)), ReservoirName(std::move(reservoir)), Municipality(std::move(municipality)), MaximumDelivery(maximumDelivery) {}
 
 int Reservoir::getId() const {return Node::getId();}
-string Reservoir::getCode() const {return Node::getCode();}
-string Reservoir::getReservoirName() const {return ReservoirName;}
-string Reservoir::getMunicipality() const {return Municipality;}
+const string& Reservoir::getCode() const {return Node::getCode();}
+const string& Reservoir::getReservoirName() const {return ReservoirName;}
+const string& Reservoir::getMunicipality() const {return Municipality;}
 int Reservoir::getMaximumDelivery() const {return MaximumDelivery;}
 
 /*------ PumpingStation class ------*/
 PumpingStation::PumpingStation(int id, string code) : Node(id, std::move(code)) {}
 
 int PumpingStation::getId() const {return Node::getId();}
-string PumpingStation::getCode() const {return Node::getCode();}
+const string& PumpingStation::getCode() const {return Node::getCode();}
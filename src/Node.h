@@ -18,10 +18,18 @@ private:
      * @details Code of node, be it a CityName, ReservoirName or pumping station
      */
     string Code;
+    /**
+     * @details Symbol of the Code in the Graph the node belongs to
+     */
+    uint32_t Symbol = 0;
     /**
      * @details List of outgoing edges, to adjacent nodes.
      */
     list<Edge*> edges = {};
+    /**
+     * @details List of incoming edges, from adjacent nodes. The edges are owned by the Graph.
+     */
+    list<Edge*> incomingEdges = {};
     /**
      * @details This variable set to True means that the node has been visited and False otherwise.
      */
@@ -32,6 +40,10 @@ private:
     Edge* path = nullptr;
 public:
     virtual ~Node() = default;
+    Node(const Node&) = default;
+    Node(Node&&) = default;
+    Node& operator=(const Node&) = default;
+    Node& operator=(Node&&) = default;
     /**
      * @details Constructor of the Node class
      * @param id Id of the node
@@ -49,13 +61,31 @@ public:
      * @details Time Complexity: O(1)
      * @return The code of a node
      */
-    virtual string getCode() const;
+    virtual const string& getCode() const;
+    /**
+     * @details Normal method that returns the symbol of the node's code
+     * @details Time Complexity: O(1)
+     * @return The symbol of the node, given by the Graph when the node was added
+     */
+    uint32_t getSymbol() const;
+    /**
+     * @details Normal method that sets the symbol of the node's code
+     * @details Time Complexity: O(1)
+     * @param symbol The symbol of the node
+     */
+    void setSymbol(uint32_t symbol);
     /**
      * @details Normal method that returns the list of edges of a node
      * @details Time Complexity: O(1)
-     * @return The list of edges of a node
+     * @return A read-only view of the list of edges of a node, valid until an edge is added to or removed from it
      */
-    list<Edge*> getEdges() const;
+    const list<Edge*>& getEdges() const;
+    /**
+     * @details Normal method that returns the list of incoming edges of a node
+     * @details Time Complexity: O(1)
+     * @return A read-only view of the list of incoming edges of a node, valid until an edge is added to or removed from it
+     */
+    const list<Edge*>& getIncomingEdges() const;
     /**
      * @details Normal method that returns the visited attribute of a node
      * @details Time Complexity: O(1)
@@ -87,11 +117,23 @@ public:
      */
     void addEdge(Edge* edge);
     /**
-     * @details Normal method that removes an edge from the list of edges of a node and deletes it
+     * @details Normal method that removes an edge from the list of edges of a node, the edge is owned by the Graph
      * @details Time Complexity: O(1)
      * @param edge The edge to be removed
      */
     void removeEdge(Edge* edge);
+    /**
+     * @details Normal method that adds an edge to the list of incoming edges of a node
+     * @details Time Complexity: O(1)
+     * @param edge The edge to be added
+     */
+    void addIncomingEdge(Edge* edge);
+    /**
+     * @details Normal method that removes an edge from the list of incoming edges of a node, without deleting it
+     * @details Time Complexity: O(in-degree)
+     * @param edge The edge to be removed
+     */
+    void removeIncomingEdge(Edge* edge);
     /**
      * @details Normal method that returns the number of edges of a node
      * @details Time Complexity: O(1)
@@ -139,13 +181,13 @@ public:
      * @details Time Complexity: O(1)
      * @return The code of a city
      */
-    string getCode() const override;
+    const string& getCode() const override;
     /**
      * @details Normal method that returns the name of the city
      * @details Time Complexity: O(1)
      * @return The name of the city
      */
-    string getCityName() const;
+    const string& getCityName() const;
     /**
      * @details Normal method that returns the demand of the city
      * @details Time Complexity: O(1)
@@ -199,19 +241,19 @@ public:
      * @details Time Complexity: O(1)
      * @return The code of a reservoir
      */
-    string getCode() const override;
+    const string& getCode() const override;
     /**
      * @details Normal method that returns the name of the reservoir
      * @details Time Complexity: O(1)
      * @return The name of the reservoir
      */
-    string getReservoirName() const;
+    const string& getReservoirName() const;
     /**
      * @details Normal method that returns the municipality of the reservoir
      * @details Time Complexity: O(1)
      * @return The municipality of the reservoir
      */
-    string getMunicipality() const;
+    const string& getMunicipality() const;
     /**
      * @details Normal method that returns the maximum delivery of the reservoir
      * @details Time Complexity: O(1)
@@ -243,7 +285,7 @@ public:
      * @details Time Complexity: O(1)
      * @return The code of a pumping station
      */
-    string getCode() const override;
+    const string& getCode() const override;
 };
 
 #endif //DA_RAILWAYS_STATION_H
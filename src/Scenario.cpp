@@ -0,0 +1,83 @@
+#include "Scenario.h"
+
+Scenario Scenario::removeReservoir(const string &code) {
+    return {ScenarioType::RemoveReservoir, code, "", 1};
+}
+
+Scenario Scenario::removePumpingStation(const string &code) {
+    return {ScenarioType::RemovePumpingStation, code, "", 1};
+}
+
+Scenario Scenario::removePipe(const string &origin, const string &destination) {
+    return {ScenarioType::RemovePipe, origin, destination, 1};
+}
+
+Scenario Scenario::scaleDemand(const string &code, double factor) {
+    return {ScenarioType::ScaleDemand, code, "", factor};
+}
+
+string Scenario::describe() const {
+    switch (type) {
+        case ScenarioType::RemoveReservoir:
+            return "reservoir " + code;
+        case ScenarioType::RemovePumpingStation:
+            return "station " + code;
+        case ScenarioType::RemovePipe:
+            return "pipe " + code + " " + destination;
+        case ScenarioType::ScaleDemand: {
+            stringstream x;
+            x << "demand " << code << " x" << fixed << setprecision(2) << factor;
+            return x.str();
+        }
+    }
+    return "";
+}
+
+list<pair<City*, double>> ScenarioTable::getDeficits(size_t scenario) const {
+    list<pair<City*, double>> result;
+    for (size_t c = 0; c < deficits[scenario].size(); c++) {
+        if (deficits[scenario][c] > 0) {
+            result.emplace_back(cities[c], deficits[scenario][c]);
+        }
+    }
+    result.sort([](const pair<City*, double>& a, const pair<City*, double>& b) {
+        return a.second > b.second;
+    });
+    return result;
+}
+
+double ScenarioTable::getTotalDeficit(const vector<double> &row) {
+    double total = 0;
+    for (double deficit : row) {
+        total += deficit;
+    }
+    return total;
+}
+
+void ScenarioTable::write(ostream &out) const {
+    auto flags = out.flags();
+    auto precision = out.precision();
+    out << fixed << setprecision(2) << "scenario\ttotal";
+    for (City* city : cities) {
+        out << '\t' << city->getCode();
+    }
+    out << "\nbaseline\t" << getTotalDeficit(baseline);
+    for (double deficit : baseline) {
+        out << '\t' << deficit;
+    }
+    out << '\n';
+    for (size_t s = 0; s < scenarios.size(); s++) {
+        out << scenarios[s];
+        if (!errors[s].empty()) {
+            out << "\terror\t" << errors[s] << '\n';
+            continue;
+        }
+        out << '\t' << getTotalDeficit(deficits[s]);
+        for (double deficit : deficits[s]) {
+            out << '\t' << deficit;
+        }
+        out << '\n';
+    }
+    out.flags(flags);
+    out.precision(precision);
+}
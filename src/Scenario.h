@@ -0,0 +1,136 @@
+#ifndef DA2324_PROJ1_SCENARIO_H
+#define DA2324_PROJ1_SCENARIO_H
+
+#include <iostream>
+#include <sstream>
+#include <iomanip>
+#include <vector>
+#include <list>
+#include "Node.h"
+
+using namespace std;
+
+/**
+ * @details Changes to the network that a Scenario can make
+ */
+enum class ScenarioType {
+    RemoveReservoir,
+    RemovePumpingStation,
+    RemovePipe,
+    ScaleDemand
+};
+
+/**
+ * @struct Scenario
+ * @details A what-if change to the network, evaluated against the max flow of the unchanged network
+ */
+struct Scenario {
+    /**
+     * @details What the scenario changes
+     */
+    ScenarioType type;
+    /**
+     * @details Code of the reservoir, pumping station or city, or of the origin of the pipe
+     */
+    string code;
+    /**
+     * @details Code of the destination of the pipe, empty for the other types
+     */
+    string destination;
+    /**
+     * @details Factor that multiplies the demand of the city, 1 for the other types
+     */
+    double factor = 1;
+    /**
+     * @details Scenario that removes a reservoir
+     * @details Time Complexity: O(1)
+     * @param code The code of the reservoir
+     * @return The scenario
+     */
+    static Scenario removeReservoir(const string &code);
+    /**
+     * @details Scenario that removes a pumping station
+     * @details Time Complexity: O(1)
+     * @param code The code of the pumping station
+     * @return The scenario
+     */
+    static Scenario removePumpingStation(const string &code);
+    /**
+     * @details Scenario that removes the pipe from one node to another, and the one back if the pipe is bidirectional
+     * @details Time Complexity: O(1)
+     * @param origin The code of the origin
+     * @param destination The code of the destination
+     * @return The scenario
+     */
+    static Scenario removePipe(const string &origin, const string &destination);
+    /**
+     * @details Scenario that multiplies the demand of a city
+     * @details Flows are whole units, so the city can then take up to the scaled demand rounded up.
+     * @details Time Complexity: O(1)
+     * @param code The code of the city
+     * @param factor The factor, 0 or more
+     * @return The scenario
+     */
+    static Scenario scaleDemand(const string &code, double factor);
+    /**
+     * @details Normal method that describes the scenario in a few words, e.g. "pipe PS_1 PS_2" or "demand C_3 x1.50"
+     * @details Time Complexity: O(1)
+     * @return The description
+     */
+    string describe() const;
+};
+
+/**
+ * @struct ScenarioTable
+ * @details Deficit of every city in every scenario of a batch, with one row per scenario and one column per city
+ * @details The demand of a city in a row is the one of its scenario, so a city whose demand was scaled up can be in deficit
+ * without losing any water.
+ */
+struct ScenarioTable {
+    /**
+     * @details The cities of the columns, in the order of the compiled network
+     */
+    vector<City*> cities;
+    /**
+     * @details Deficit of each city in the max flow of the unchanged network
+     */
+    vector<double> baseline;
+    /**
+     * @details Deficit of each city in each scenario, empty for the scenarios that couldn't be evaluated
+     */
+    vector<vector<double>> deficits;
+    /**
+     * @details Description of each scenario
+     */
+    vector<string> scenarios;
+    /**
+     * @details Why each scenario couldn't be evaluated, empty for the ones that were
+     */
+    vector<string> errors;
+    /**
+     * @details Normal method that returns the cities in deficit in a scenario, like the resiliency checks do
+     * @details Time Complexity: O(C * log(C))
+     * @details C is the number of cities.
+     * @param scenario Row of the scenario
+     * @return The cities with a deficit and their deficit, the largest first
+     */
+    list<pair<City*, double>> getDeficits(size_t scenario) const;
+    /**
+     * @details Normal method that returns the total deficit of a row
+     * @details Time Complexity: O(C)
+     * @details C is the number of cities.
+     * @param row Deficits of a row, or the baseline
+     * @return The sum of the deficits
+     */
+    static double getTotalDeficit(const vector<double> &row);
+    /**
+     * @details Writes the table as tab-separated values: a header with the city codes, the baseline, and a row per
+     * scenario with its total deficit followed by the deficit of each city
+     * @details Time Complexity: O(S * C)
+     * @details S is the number of scenarios and C the number of cities.
+     * @param out Where the table is written
+     */
+    void write(ostream &out) const;
+};
+
+#endif //DA2324_PROJ1_SCENARIO_H
@@ -0,0 +1,172 @@
+#include "Snapshot.h"
+
+/**
+ * @details Number of words of the header and of each node record
+ */
+static const size_t HeaderWords = 6;
+static const size_t NodeWords = 8;
+
+/**
+ * @details Appends a string to the string pool
+ * @param pool The string pool
+ * @param str The string
+ * @return The offset of the string in the pool
+ */
+static uint32_t addString(string &pool, const string &str) {
+    auto offset = (uint32_t) pool.size();
+    pool += str;
+    pool += '\0';
+    return offset;
+}
+
+/**
+ * @details Appends the 32-bit words of an array to a buffer
+ * @param buffer The buffer
+ * @param words The array
+ */
+template <typename T>
+static void appendWords(string &buffer, const vector<T> &words) {
+    static_assert(sizeof(T) == sizeof(uint32_t), "arrays are made of 32-bit words");
+    buffer.append((const char*) words.data(), words.size() * sizeof(T));
+}
+
+string Snapshot::encode(const Graph &graph, bool withFlows) {
+    const vector<Node*>& nodes = graph.getNodes();
+    vector<uint32_t> position(nodes.size(), 0);
+    vector<uint32_t> table;
+    vector<uint32_t> origins, dests, flows;
+    vector<int32_t> capacities;
+    string pool;
+    uint32_t nodeCount = 0;
+    for (auto node : nodes) {
+        if (node == nullptr) {
+            continue;
+        }
+        position[node->getSymbol()] = nodeCount++;
+        uint32_t record[NodeWords] = {0, (uint32_t) node->getId(), addString(pool, node->getCode()), 0, 0, 0, 0, 0};
+        if (auto* reservoir = dynamic_cast<Reservoir*>(node)) {
+            record[0] = 1;
+            record[3] = addString(pool, reservoir->getReservoirName());
+            record[4] = addString(pool, reservoir->getMunicipality());
+            record[5] = (uint32_t) reservoir->getMaximumDelivery();
+        } else if (auto* city = dynamic_cast<City*>(node)) {
+            float demand = city->getDemand();
+            record[0] = 2;
+            record[3] = addString(pool, city->getCityName());
+            record[5] = (uint32_t) city->getPopulation();
+            memcpy(&record[6], &demand, sizeof(float));
+        }
+        table.insert(table.end(), record, record + NodeWords);
+    }
+    for (auto node : nodes) {
+        if (node == nullptr) {
+            continue;
+        }
+        for (auto e : node->getEdges()) {
+            origins.push_back(position[e->getOrigin()]);
+            dests.push_back(position[e->getDest()]);
+            capacities.push_back(e->getCapacity());
+            flows.push_back((uint32_t) e->getFlow());
+        }
+    }
+    uint32_t header[HeaderWords] = {Magic, Version, withFlows ? 1u : 0u, nodeCount, (uint32_t) origins.size(), (uint32_t) pool.size()};
+
+    string image((const char*) header, sizeof(header));
+    image.reserve(sizeof(header) + (table.size() + origins.size() * 4) * sizeof(uint32_t) + pool.size());
+    appendWords(image, table);
+    appendWords(image, origins);
+    appendWords(image, dests);
+    appendWords(image, capacities);
+    if (withFlows) {
+        appendWords(image, flows);
+    }
+    image += pool;
+    return image;
+}
+
+bool Snapshot::save(const string &path, const string &image) {
+    string temporary = path + ".tmp";
+    ofstream output(temporary, ios::binary | ios::trunc);
+    if (!output.is_open()) {
+        return false;
+    }
+    output.write(image.data(), (streamsize) image.size());
+    output.close();
+    if (!output) {
+        remove(temporary.c_str());
+        return false;
+    }
+    remove(path.c_str());
+    return rename(temporary.c_str(), path.c_str()) == 0;
+}
+
+bool Snapshot::write(const Graph &graph, const string &path, bool withFlows) {
+    return save(path, encode(graph, withFlows));
+}
+
+bool Snapshot::read(Graph &graph, const string &path, size_t &bytes, long long &records, bool &hasFlows) {
+    MappedFile file(path);
+    if (!file.isOpen() || file.getSize() < HeaderWords * sizeof(uint32_t)) {
+        return false;
+    }
+    const char* data = file.getData();
+    uint32_t header[HeaderWords];
+    memcpy(header, data, sizeof(header));
+    if (header[0] != Magic || header[1] != Version) {
+        return false;
+    }
+    hasFlows = (header[2] & 1u) != 0;
+    size_t nodeCount = header[3], edgeCount = header[4], poolSize = header[5];
+    size_t edgeArrays = hasFlows ? 4 : 3;
+    size_t expected = (HeaderWords + nodeCount * NodeWords + edgeCount * edgeArrays) * sizeof(uint32_t) + poolSize;
+    if (file.getSize() != expected || (poolSize > 0 && data[expected - 1] != '\0')) {
+        return false;
+    }
+    auto word = [data](size_t index) {
+        uint32_t value;
+        memcpy(&value, data + index * sizeof(uint32_t), sizeof(uint32_t));
+        return value;
+    };
+    size_t tableStart = HeaderWords;
+    size_t origins = tableStart + nodeCount * NodeWords, dests = origins + edgeCount, capacities = dests + edgeCount;
+    size_t flows = capacities + edgeCount;
+    const char* pool = data + expected - poolSize;
+
+    for (size_t i = 0; i < nodeCount; i++) {
+        const size_t record = tableStart + i * NodeWords;
+        if (word(record) > 2 || word(record + 2) >= poolSize || word(record + 3) >= poolSize || word(record + 4) >= poolSize) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < edgeCount; i++) {
+        if (word(origins + i) >= nodeCount || word(dests + i) >= nodeCount) {
+            return false;
+        }
+    }
+
+    vector<uint32_t> symbols(nodeCount);
+    for (size_t i = 0; i < nodeCount; i++) {
+        const size_t record = tableStart + i * NodeWords;
+        string code = pool + word(record + 2);
+        if (word(record) == 1) {
+            graph.addNode(Reservoir((int) word(record + 1), code, pool + word(record + 3), pool + word(record + 4), (int) word(record + 5)));
+        } else if (word(record) == 2) {
+            float demand;
+            uint32_t bits = word(record + 6);
+            memcpy(&demand, &bits, sizeof(float));
+            graph.addNode(City((int) word(record + 1), code, pool + word(record + 3), demand, (int) word(record + 5)));
+        } else {
+            graph.addNode(PumpingStation((int) word(record + 1), code));
+        }
+        symbols[i] = graph.getNode(code)->getSymbol();
+    }
+    for (size_t i = 0; i < edgeCount; i++) {
+        Edge* edge = graph.addEdge(symbols[word(origins + i)], symbols[word(dests + i)], (int) word(capacities + i));
+        if (hasFlows) {
+            edge->setFlow((int) word(flows + i));
+        }
+    }
+    bytes = file.getSize();
+    records = (long long) (nodeCount + edgeCount);
+    return true;
+}
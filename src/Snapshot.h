@@ -0,0 +1,81 @@
+#ifndef DA2324_PROJ1_SNAPSHOT_H
+#define DA2324_PROJ1_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include "Graph.h"
+#include "MappedFile.h"
+
+/**
+ * @class Snapshot
+ * @details Versioned binary image of a loaded Graph, optionally with the flow of every edge, that can be mapped back
+ * into memory instead of parsing the CSV files again.
+ * @details Every field is a 32-bit word in the byte order of the machine, little-endian on every supported platform,
+ * so a snapshot from a machine with another byte order fails the magic check. The file holds, in order:
+ * @details - a header: magic "DAWS", version, flags (bit 0 set when flows are present), node count, edge count and
+ * size of the string pool;
+ * @details - the node table, 8 words per node: type (0 pumping station, 1 reservoir, 2 city), id, offsets of the code,
+ * the name and the municipality in the string pool, maximum delivery or population, demand (as a float) and a padding word;
+ * @details - the edge arrays: origin, destination and capacity of every edge, the endpoints given as positions in the
+ * node table, followed by the flow of every edge when bit 0 of the flags is set;
+ * @details - the string pool, with every string terminated by a null byte.
+ */
+class Snapshot {
+public:
+    /**
+     * @details First word of every snapshot, "DAWS" in little-endian
+     */
+    static const uint32_t Magic = 0x53574144;
+    /**
+     * @details Version of the format, increased whenever the layout changes
+     */
+    static const uint32_t Version = 1;
+    /**
+     * @details Builds the snapshot of a Graph in memory, so it can be saved later, e.g. on another thread
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param graph The Graph
+     * @param withFlows True to also save the flow of every edge
+     * @return The contents of the snapshot
+     */
+    static string encode(const Graph &graph, bool withFlows);
+    /**
+     * @details Saves an encoded snapshot, replacing the file only once it is complete
+     * @details Time Complexity: O(N)
+     * @details N is the size of the snapshot.
+     * @param path Path of the snapshot
+     * @param image The contents of the snapshot
+     * @return True - If the snapshot was written.
+     * @return False - If the file couldn't be written.
+     */
+    static bool save(const string &path, const string &image);
+    /**
+     * @details Writes a snapshot of a Graph, replacing the file only once it is complete
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param graph The Graph
+     * @param path Path of the snapshot
+     * @param withFlows True to also save the flow of every edge
+     * @return True - If the snapshot was written.
+     * @return False - If the file couldn't be written.
+     */
+    static bool write(const Graph &graph, const string &path, bool withFlows);
+    /**
+     * @details Maps a snapshot and adds its nodes and edges to an empty Graph
+     * @details The whole file is validated before the Graph is changed, so a corrupted or outdated snapshot leaves it empty.
+     * @details Time Complexity: O(|V| + |E|)
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param graph The Graph to fill
+     * @param path Path of the snapshot
+     * @param bytes Size of the snapshot
+     * @param records Number of nodes and edges read
+     * @param hasFlows True if the flow of every edge was restored into its Edge
+     * @return True - If the snapshot was read.
+     * @return False - If it is missing, of another version or corrupted.
+     */
+    static bool read(Graph &graph, const string &path, size_t &bytes, long long &records, bool &hasFlows);
+};
+
+#endif //DA2324_PROJ1_SNAPSHOT_H
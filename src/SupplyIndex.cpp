@@ -0,0 +1,242 @@
+#include "SupplyIndex.h"
+
+SupplyIndex::SupplyIndex() = default;
+
+SupplyIndex::SupplyIndex(const FlowNetwork &network) {
+    buildDominators(network);
+    buildBridges(network);
+}
+
+void SupplyIndex::buildDominators(const FlowNetwork &network) {
+    int n = network.getNumNodes(), source = network.getSource();
+
+    // Postorder of the nodes that the super source reaches through arcs with capacity
+    vector<int> postorder, position(n, -1), nextArc(n, 0), stack = {source};
+    vector<bool> seen(n, false);
+    seen[source] = true;
+    nextArc[source] = network.getFirstArc(source);
+    while (!stack.empty()) {
+        int v = stack.back();
+        if (nextArc[v] < network.getFirstArc(v + 1)) {
+            int a = nextArc[v]++;
+            int w = network.getHead(a);
+            if (network.getCapacity(a) > 0 && !seen[w]) {
+                seen[w] = true;
+                nextArc[w] = network.getFirstArc(w);
+                stack.push_back(w);
+            }
+        } else {
+            position[v] = (int) postorder.size();
+            postorder.push_back(v);
+            stack.pop_back();
+        }
+    }
+
+    // Predecessors of each node through the same arcs, in compressed rows
+    vector<int> firstPredecessor(n + 1, 0);
+    for (int u : postorder) {
+        for (int a = network.getFirstArc(u); a < network.getFirstArc(u + 1); a++) {
+            if (network.getCapacity(a) > 0) {
+                firstPredecessor[network.getHead(a) + 1]++;
+            }
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        firstPredecessor[v + 1] += firstPredecessor[v];
+    }
+    vector<int> predecessors(firstPredecessor[n]), next(firstPredecessor.begin(), firstPredecessor.end() - 1);
+    for (int u : postorder) {
+        for (int a = network.getFirstArc(u); a < network.getFirstArc(u + 1); a++) {
+            if (network.getCapacity(a) > 0) {
+                predecessors[next[network.getHead(a)]++] = u;
+            }
+        }
+    }
+
+    // Immediate dominators, refined in reverse postorder until they don't change
+    vector<int> idom(n, -1);
+    idom[source] = source;
+    for (bool changed = true; changed;) {
+        changed = false;
+        for (int i = (int) postorder.size() - 2; i >= 0; i--) {
+            int v = postorder[i];
+            int dominator = -1;
+            for (int p = firstPredecessor[v]; p < firstPredecessor[v + 1]; p++) {
+                int u = predecessors[p];
+                if (idom[u] < 0) {
+                    continue;
+                }
+                if (dominator < 0) {
+                    dominator = u;
+                    continue;
+                }
+                while (u != dominator) {
+                    while (position[u] < position[dominator]) u = idom[u];
+                    while (position[dominator] < position[u]) dominator = idom[dominator];
+                }
+            }
+            if (dominator != idom[v]) {
+                idom[v] = dominator;
+                changed = true;
+            }
+        }
+    }
+
+    // Preorder of the dominator tree, so that every subtree is a range of positions
+    vector<int> firstChild(n + 1, 0);
+    for (int v : postorder) {
+        if (v != source) {
+            firstChild[idom[v] + 1]++;
+        }
+    }
+    for (int v = 0; v < n; v++) {
+        firstChild[v + 1] += firstChild[v];
+    }
+    vector<int> children(firstChild[n]);
+    next.assign(firstChild.begin(), firstChild.end() - 1);
+    for (int v : postorder) {
+        if (v != source) {
+            children[next[idom[v]]++] = v;
+        }
+    }
+    dominatorOrder.assign(n, -1);
+    dominatorSize.assign(n, 0);
+    vector<int> preorder;
+    stack = {source};
+    while (!stack.empty()) {
+        int v = stack.back();
+        stack.pop_back();
+        dominatorOrder[v] = (int) preorder.size();
+        preorder.push_back(v);
+        for (int c = firstChild[v]; c < firstChild[v + 1]; c++) {
+            stack.push_back(children[c]);
+        }
+    }
+    for (int i = (int) preorder.size() - 1; i >= 0; i--) {
+        int v = preorder[i];
+        dominatorSize[v]++;
+        if (v != source) {
+            dominatorSize[idom[v]] += dominatorSize[v];
+        }
+        if (auto* city = dynamic_cast<City*>(network.getNode(v))) {
+            dominatorCities.emplace_back(dominatorOrder[v], city);
+        }
+    }
+    sort(dominatorCities.begin(), dominatorCities.end());
+}
+
+void SupplyIndex::buildBridges(const FlowNetwork &network) {
+    int n = network.getNumNodes();
+    pipeOrder.assign(n, -1);
+    pipeSize.assign(n, 0);
+    pipeComponent.assign(n, -1);
+    pipeParent.assign(n, -1);
+    bridgeSide.assign(n, 0);
+    vector<int> low(n, 0), reservoirs(n, 0), nextArc(n, 0), stack;
+    int visited = 0;
+    for (int root = 0; root < n; root++) {
+        if (root == network.getSource() || root == network.getSink() || pipeOrder[root] >= 0) {
+            continue;
+        }
+        // Nodes of this component below a bridge
+        vector<int> found;
+        pipeOrder[root] = low[root] = visited++;
+        pipeComponent[root] = root;
+        nextArc[root] = network.getFirstArc(root);
+        stack = {root};
+        while (!stack.empty()) {
+            int v = stack.back();
+            if (nextArc[v] < network.getFirstArc(v + 1)) {
+                int a = nextArc[v]++;
+                int w = network.getHead(a);
+                // Arcs of the super source and sink have no Edge in either direction, and every arc back to the
+                // parent belongs to the pipe that was followed to reach this node
+                if ((network.getEdge(a) == nullptr && network.getEdge(network.getReverse(a)) == nullptr) || w == pipeParent[v]) {
+                    continue;
+                }
+                if (pipeOrder[w] < 0) {
+                    pipeOrder[w] = low[w] = visited++;
+                    pipeComponent[w] = root;
+                    pipeParent[w] = v;
+                    nextArc[w] = network.getFirstArc(w);
+                    stack.push_back(w);
+                } else {
+                    low[v] = min(low[v], pipeOrder[w]);
+                }
+            } else {
+                stack.pop_back();
+                pipeSize[v]++;
+                if (dynamic_cast<Reservoir*>(network.getNode(v))) {
+                    reservoirs[v]++;
+                }
+                // A city the reservoirs don't reach has no supply to lose
+                auto* city = dynamic_cast<City*>(network.getNode(v));
+                if (city != nullptr && dominatorOrder[v] >= 0) {
+                    pipeCities.emplace_back(pipeOrder[v], city);
+                }
+                if (!stack.empty()) {
+                    int p = stack.back();
+                    low[p] = min(low[p], low[v]);
+                    pipeSize[p] += pipeSize[v];
+                    reservoirs[p] += reservoirs[v];
+                    if (low[v] > pipeOrder[p]) {
+                        found.push_back(v);
+                    }
+                }
+            }
+        }
+        bridges += (int) found.size();
+        for (int below : found) {
+            if (reservoirs[below] == 0) {
+                bridgeSide[below] = 1;
+            } else if (reservoirs[root] == reservoirs[below]) {
+                bridgeSide[below] = 2;
+            }
+        }
+    }
+    sort(pipeCities.begin(), pipeCities.end());
+}
+
+void SupplyIndex::addCities(const vector<pair<int, City*>> &cities, int from, int to, vector<City*> &result) {
+    auto it = lower_bound(cities.begin(), cities.end(), from, [](const pair<int, City*>& city, int position) {
+        return city.first < position;
+    });
+    for (; it != cities.end() && it->first < to; it++) {
+        result.push_back(it->second);
+    }
+}
+
+vector<City*> SupplyIndex::getCitiesCutOffByNode(int v) const {
+    vector<City*> cities;
+    if (v < 0 || v >= (int) dominatorOrder.size() || dominatorOrder[v] < 0) {
+        return cities;
+    }
+    // The node itself is the first position of its subtree
+    addCities(dominatorCities, dominatorOrder[v] + 1, dominatorOrder[v] + dominatorSize[v], cities);
+    return cities;
+}
+
+vector<City*> SupplyIndex::getCitiesCutOffByPipe(int u, int v) const {
+    vector<City*> cities;
+    int n = (int) pipeParent.size();
+    if (u < 0 || v < 0 || u >= n || v >= n) {
+        return cities;
+    }
+    // A bridge is always a pipe of the depth-first search forest, between a node and its parent
+    int below = pipeParent[v] == u ? v : pipeParent[u] == v ? u : -1;
+    if (below < 0 || bridgeSide[below] == 0) {
+        return cities;
+    }
+    int root = pipeComponent[below];
+    if (bridgeSide[below] == 1) {
+        addCities(pipeCities, pipeOrder[below], pipeOrder[below] + pipeSize[below], cities);
+    } else {
+        addCities(pipeCities, pipeOrder[root], pipeOrder[below], cities);
+        addCities(pipeCities, pipeOrder[below] + pipeSize[below], pipeOrder[root] + pipeSize[root], cities);
+    }
+    return cities;
+}
+
+int SupplyIndex::getNumBridges() const {
+    return bridges;
+}
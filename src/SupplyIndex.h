@@ -0,0 +1,123 @@
+#ifndef DA2324_PROJ1_SUPPLYINDEX_H
+#define DA2324_PROJ1_SUPPLYINDEX_H
+
+#include <vector>
+#include "FlowNetwork.h"
+
+using namespace std;
+
+/**
+ * @class SupplyIndex
+ * @details Structural index of a compiled FlowNetwork that tells, without solving any flow, which cities lose all
+ * of their supply when a node or a pipe is removed.
+ * @details Nodes: a dominator tree of the network from the super source. A node dominates a city when every path from
+ * a reservoir to the city goes through it, so removing a node cuts off exactly the cities in its dominator subtree.
+ * @details Pipes: the bridges of the pipes seen as an undirected graph, found with Tarjan's algorithm. A pipe is every
+ * edge between two nodes, in both directions. When removing a bridge leaves one of its sides without a reservoir, the
+ * cities on that side are cut off. A pipe that isn't a bridge may still cut cities off because of the directions of
+ * the other pipes, so for pipes this answer is only a lower bound.
+ * @details The sets are answered as ranges of a preorder numbering of the trees, so each one takes O(log C + K).
+ */
+class SupplyIndex {
+private:
+    /**
+     * @details Position of each node in a preorder walk of the dominator tree, -1 for nodes the super source can't reach
+     */
+    vector<int> dominatorOrder;
+    /**
+     * @details Number of nodes in the dominator subtree of each node, including itself
+     */
+    vector<int> dominatorSize;
+    /**
+     * @details Cities that the super source reaches, with their position in the dominator tree, sorted by it
+     */
+    vector<pair<int, City*>> dominatorCities;
+    /**
+     * @details Position of each node in the depth-first search forest of the pipes, -1 for the super source and sink
+     */
+    vector<int> pipeOrder;
+    /**
+     * @details Number of nodes in the depth-first search subtree of each node, including itself
+     */
+    vector<int> pipeSize;
+    /**
+     * @details Root of the depth-first search tree, which is the connected component, of each node
+     */
+    vector<int> pipeComponent;
+    /**
+     * @details Parent of each node in the depth-first search forest, -1 for the roots
+     */
+    vector<int> pipeParent;
+    /**
+     * @details Cities that the super source reaches, with their position in the depth-first search forest, sorted by it
+     */
+    vector<pair<int, City*>> pipeCities;
+    /**
+     * @details What the pipe from each node to its parent cuts off: 0 nothing, 1 the subtree of the node, 2 the rest of its component
+     */
+    vector<int> bridgeSide;
+    /**
+     * @details Number of bridges in the pipes
+     */
+    int bridges = 0;
+    /**
+     * @details Computes the dominator tree from the super source, with the iterative algorithm of Cooper, Harvey and Kennedy
+     * @details Time Complexity: O(|V| + |E|) per pass, with few passes on networks like these
+     * @param network The compiled network
+     */
+    void buildDominators(const FlowNetwork &network);
+    /**
+     * @details Finds the bridges of the pipes with Tarjan's low-link algorithm, and the side each of them cuts off
+     * @details Needs the dominator tree, to leave out the cities that the super source doesn't reach
+     * @details Time Complexity: O(|V| + |E|)
+     * @param network The compiled network
+     */
+    void buildBridges(const FlowNetwork &network);
+    /**
+     * @details Adds the cities with a position in [from, to) to a list
+     * @details Time Complexity: O(log C + K)
+     * @details C is the number of cities and K the number of cities added.
+     * @param cities Cities sorted by position
+     * @param from First position
+     * @param to Position after the last one
+     * @param result The list
+     */
+    static void addCities(const vector<pair<int, City*>> &cities, int from, int to, vector<City*> &result);
+public:
+    /**
+     * @details Creates an empty SupplyIndex.
+     */
+    SupplyIndex();
+    /**
+     * @details Builds the index of a compiled network. Only the capacities are used, not the flows.
+     * @details Time Complexity: O(|V| + |E|) in practice
+     * @details V is the number of vertices/nodes and E is the number of edges/links.
+     * @param network The compiled network
+     */
+    explicit SupplyIndex(const FlowNetwork &network);
+    /**
+     * @details Finds the cities that lose all of their supply when a node is removed
+     * @details Time Complexity: O(log C + K)
+     * @details C is the number of cities and K the number of cities found.
+     * @param v Index of the node in the network
+     * @return The cities, without the node itself, in no particular order
+     */
+    vector<City*> getCitiesCutOffByNode(int v) const;
+    /**
+     * @details Finds cities that lose all of their supply when the pipe between two nodes is removed, in both directions
+     * @details Time Complexity: O(log C + K)
+     * @details C is the number of cities and K the number of cities found.
+     * @param u Index of one end of the pipe in the network
+     * @param v Index of the other end of the pipe in the network
+     * @return The cities, in no particular order, empty if the pipe isn't a bridge or both of its sides have a reservoir
+     */
+    vector<City*> getCitiesCutOffByPipe(int u, int v) const;
+    /**
+     * @details Normal method that returns the number of bridges in the pipes
+     * @details Time Complexity: O(1)
+     * @return The number of bridges
+     */
+    int getNumBridges() const;
+};
+
+#endif //DA2324_PROJ1_SUPPLYINDEX_H
@@ -0,0 +1,25 @@
+#include "SymbolTable.h"
+
+uint32_t SymbolTable::intern(const string &code) {
+    auto it = symbols.find(code);
+    if (it != symbols.end()) {
+        return it->second;
+    }
+    auto symbol = (uint32_t) codes.size();
+    symbols.emplace(code, symbol);
+    codes.push_back(code);
+    return symbol;
+}
+
+bool SymbolTable::find(const string &code, uint32_t &symbol) const {
+    auto it = symbols.find(code);
+    if (it == symbols.end()) {
+        return false;
+    }
+    symbol = it->second;
+    return true;
+}
+
+const string& SymbolTable::getCode(uint32_t symbol) const {return codes[symbol];}
+
+size_t SymbolTable::size() const {return codes.size();}
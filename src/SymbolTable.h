@@ -0,0 +1,58 @@
+#ifndef DA2324_PROJ1_SYMBOLTABLE_H
+#define DA2324_PROJ1_SYMBOLTABLE_H
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+using namespace std;
+
+/**
+ * @class SymbolTable
+ * @details Interns the codes of the nodes, like "PS_71" or "C_1", giving each one a dense 32-bit id (symbol).
+ * @details Symbols are given in the order the codes are first seen and never change, so they can be used as indexes.
+ */
+class SymbolTable {
+private:
+    /**
+     * @details Symbol of each code
+     */
+    unordered_map<string, uint32_t> symbols;
+    /**
+     * @details Code of each symbol
+     */
+    vector<string> codes;
+public:
+    /**
+     * @details Returns the symbol of a code, giving it a new one if it wasn't interned yet
+     * @details Time Complexity: O(1)
+     * @param code The code
+     * @return The symbol of the code
+     */
+    uint32_t intern(const string &code);
+    /**
+     * @details Finds the symbol of a code without interning it
+     * @details Time Complexity: O(1)
+     * @param code The code
+     * @param symbol The symbol of the code, if it was found
+     * @return True - If the code was interned.
+     * @return False - If it wasn't.
+     */
+    bool find(const string &code, uint32_t &symbol) const;
+    /**
+     * @details Normal method that returns the code of a symbol
+     * @details Time Complexity: O(1)
+     * @param symbol The symbol
+     * @return The code of the symbol
+     */
+    const string& getCode(uint32_t symbol) const;
+    /**
+     * @details Normal method that returns the number of interned codes
+     * @details Time Complexity: O(1)
+     * @return The number of symbols
+     */
+    size_t size() const;
+};
+
+#endif //DA2324_PROJ1_SYMBOLTABLE_H